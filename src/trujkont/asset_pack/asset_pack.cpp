@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <ranges>
+#include <atomic>
+#include <array>
+
+#include "trujkont/asset_pack/asset_pack.hpp"
+
+#include "trujkont/hash/hash.hpp"
+
+#include <fmt/format.h>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #include <fcntl.h>
+#endif
+
+namespace
+{
+
+auto constexpr file_magic = std::array { 'T', 'R', 'J', 'K', 'P', 'A', 'C', 'K' };
+auto constexpr file_version = std::uint32_t(1);
+
+struct FileHeader
+{
+  std::array<char, 8> magic = file_magic;
+  std::uint32_t version = file_version;
+  std::uint32_t assets_count = 0;
+  std::uint64_t names_offset = 0;
+  std::uint64_t names_size = 0;
+};
+
+static_assert(sizeof(FileHeader) == 32);
+
+// `AssetPack::Entry` as stored, kept apart so the in memory one is free to change.
+struct FileEntry
+{
+  std::uint64_t name_hash = 0;
+  std::uint64_t content_hash = 0;
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+  std::uint32_t name_offset = 0;
+  std::uint32_t name_size = 0;
+};
+
+static_assert(sizeof(FileEntry) == 40);
+
+auto align_up(std::size_t const offset) -> std::size_t
+{
+  return (offset + AssetPack::blob_alignment - 1) / AssetPack::blob_alignment * AssetPack::blob_alignment;
+}
+
+auto pack = tl::optional<AssetPack>();
+
+auto assets_found = std::atomic<std::uint64_t>(0);
+auto assets_missed = std::atomic<std::uint64_t>(0);
+
+} // namespace
+
+auto AssetPack::serialize(std::span<Asset const> const assets) -> std::vector<std::byte>
+{
+  auto entries = std::vector<FileEntry>();
+  entries.reserve(assets.size());
+
+  auto names = std::string();
+
+  for(auto const& asset : assets) {
+    auto const name_hash = hash::fnv1a64(asset.name);
+
+    auto const duplicate = std::ranges::find_if(entries, [&](FileEntry const& entry) {
+      return entry.name_hash == name_hash and std::string_view(names).substr(entry.name_offset, entry.name_size) == asset.name;
+    });
+
+    if(duplicate != entries.end()) throw std::invalid_argument(fmt::format("\"{}\" is in the pack twice", asset.name));
+
+    entries.push_back(FileEntry {
+      .name_hash = name_hash,
+      .content_hash = hash::fnv1a64(asset.bytes),
+      .offset = 0,
+      .size = asset.bytes.size(),
+      .name_offset = static_cast<std::uint32_t>(names.size()),
+      .name_size = static_cast<std::uint32_t>(asset.name.size()),
+    });
+
+    names += asset.name;
+  }
+
+  auto const header = FileHeader {
+    .assets_count = static_cast<std::uint32_t>(assets.size()),
+    .names_offset = sizeof(FileHeader) + entries.size() * sizeof(FileEntry),
+    .names_size = names.size(),
+  };
+
+  auto end = align_up(header.names_offset + header.names_size);
+
+  // Blobs are placed in the order they were given, so assets used together can be kept on neighbouring pages.
+  for(auto i = std::size_t(0); i < assets.size(); ++i) {
+    auto const earlier = std::views::iota(std::size_t(0), i);
+    auto const same_content = std::ranges::find_if(earlier, [&](std::size_t const other) {
+      return entries[other].content_hash == entries[i].content_hash and std::ranges::equal(assets[other].bytes, assets[i].bytes);
+    });
+
+    if(same_content != earlier.end()) {
+      entries[i].offset = entries[*same_content].offset;
+      continue;
+    }
+
+    entries[i].offset = end;
+    end = align_up(end + assets[i].bytes.size());
+  }
+
+  auto bytes = std::vector<std::byte>(end);
+
+  for(auto i = std::size_t(0); i < assets.size(); ++i) {
+    std::ranges::copy(assets[i].bytes, bytes.begin() + static_cast<std::ptrdiff_t>(entries[i].offset));
+  }
+
+  std::ranges::sort(entries, {}, &FileEntry::name_hash);
+
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  std::memcpy(bytes.data() + sizeof(header), entries.data(), entries.size() * sizeof(FileEntry));
+  std::memcpy(bytes.data() + header.names_offset, names.data(), names.size());
+
+  return bytes;
+}
+
+auto AssetPack::normalized_name(std::filesystem::path const& path) -> std::string
+{
+  return path.lexically_normal().generic_string();
+}
+
+auto AssetPack::open(std::filesystem::path const& path) -> tl::expected<AssetPack, std::string>
+{
+  auto result = AssetPack();
+
+#if defined(__linux__)
+  auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd == -1) return tl::make_unexpected(fmt::format("Cannot find asset pack @ \"{}\"", path.c_str()));
+
+  struct stat status = {};
+  auto const size = fstat(fd, &status) == 0 ? static_cast<std::size_t>(status.st_size) : std::size_t(0);
+
+  // A mapping outlives its descriptor, the file is never touched through it again.
+  auto* const mapping = size < sizeof(FileHeader) ? MAP_FAILED : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(mapping == MAP_FAILED) return tl::make_unexpected(fmt::format("Cannot map asset pack @ \"{}\"", path.c_str()));
+
+  result.mapped = static_cast<std::byte const*>(mapping);
+  result.mapped_size = size;
+#else
+  auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+  if(not file) return tl::make_unexpected(fmt::format("Cannot find asset pack @ \"{}\"", path.c_str()));
+
+  result.read_bytes.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(result.read_bytes.data()), static_cast<std::streamsize>(result.read_bytes.size())); // NOLINT
+
+  if(not file) return tl::make_unexpected(fmt::format("Cannot read asset pack @ \"{}\"", path.c_str()));
+
+  result.mapped = result.read_bytes.data();
+  result.mapped_size = result.read_bytes.size();
+#endif
+
+  auto header = FileHeader();
+  if(result.mapped_size < sizeof(header)) return tl::make_unexpected("Too short for an asset pack header");
+
+  std::memcpy(&header, result.mapped, sizeof(header));
+
+  if(header.magic != file_magic) return tl::make_unexpected(fmt::format("\"{}\" is not an asset pack", path.c_str()));
+
+  if(header.version != file_version) {
+    return tl::make_unexpected(fmt::format("Asset pack version {}, expected {}", header.version, file_version));
+  }
+
+  auto const entries_end = sizeof(header) + std::size_t(header.assets_count) * sizeof(FileEntry);
+
+  if(entries_end > result.mapped_size or header.names_offset < entries_end or header.names_offset > result.mapped_size
+     or header.names_size > result.mapped_size - header.names_offset) {
+    return tl::make_unexpected("Asset pack index is out of the file's bounds");
+  }
+
+  result.names_offset = header.names_offset;
+  result.entries.resize(header.assets_count);
+
+  for(auto i = std::size_t(0); i < result.entries.size(); ++i) {
+    auto stored = FileEntry();
+    std::memcpy(&stored, result.mapped + sizeof(header) + i * sizeof(FileEntry), sizeof(stored));
+
+    if(std::uint64_t(stored.name_offset) + stored.name_size > header.names_size or stored.offset > result.mapped_size
+       or stored.size > result.mapped_size - stored.offset) {
+      return tl::make_unexpected(fmt::format("Asset {} is out of the file's bounds", i));
+    }
+
+    result.entries[i] = Entry {
+      .name_hash = stored.name_hash,
+      .content_hash = stored.content_hash,
+      .offset = stored.offset,
+      .size = stored.size,
+      .name_offset = stored.name_offset,
+      .name_size = stored.name_size,
+    };
+  }
+
+  if(not std::ranges::is_sorted(result.entries, {}, &Entry::name_hash)) return tl::make_unexpected("Asset pack index is not sorted");
+
+  return result;
+}
+
+AssetPack::AssetPack(AssetPack&& other) noexcept
+  : mapped(std::exchange(other.mapped, nullptr)),
+    mapped_size(std::exchange(other.mapped_size, 0)),
+    read_bytes(std::move(other.read_bytes)),
+    entries(std::move(other.entries)),
+    names_offset(other.names_offset)
+{}
+
+auto AssetPack::operator=(AssetPack&& other) noexcept -> AssetPack&
+{
+  if(this == &other) return *this;
+
+  release();
+
+  mapped = std::exchange(other.mapped, nullptr);
+  mapped_size = std::exchange(other.mapped_size, 0);
+  read_bytes = std::move(other.read_bytes);
+  entries = std::move(other.entries);
+  names_offset = other.names_offset;
+
+  return *this;
+}
+
+AssetPack::~AssetPack()
+{
+  release();
+}
+
+auto AssetPack::find(std::string_view const name) const -> tl::optional<std::span<std::byte const>>
+{
+  auto const [first, last] = std::ranges::equal_range(entries, hash::fnv1a64(name), {}, &Entry::name_hash);
+
+  for(auto const& entry : std::ranges::subrange(first, last)) {
+    if(name_of(entry) == name) return blob_of(entry);
+  }
+
+  return tl::nullopt;
+}
+
+auto AssetPack::verify() const -> std::vector<std::string>
+{
+  auto corrupt = std::vector<std::string>();
+
+  for(auto const& entry : entries) {
+    if(hash::fnv1a64(blob_of(entry)) != entry.content_hash) corrupt.emplace_back(name_of(entry));
+  }
+
+  return corrupt;
+}
+
+auto AssetPack::assets_count() const noexcept -> std::size_t
+{
+  return entries.size();
+}
+
+auto AssetPack::size() const noexcept -> std::size_t
+{
+  return mapped_size;
+}
+
+auto AssetPack::name_of(Entry const& entry) const -> std::string_view
+{
+  return { reinterpret_cast<char const*>(mapped + names_offset + entry.name_offset), entry.name_size }; // NOLINT
+}
+
+auto AssetPack::blob_of(Entry const& entry) const -> std::span<std::byte const>
+{
+  return { mapped + entry.offset, static_cast<std::size_t>(entry.size) };
+}
+
+auto AssetPack::release() noexcept -> void
+{
+#if defined(__linux__)
+  if(mapped) munmap(const_cast<std::byte*>(mapped), mapped_size); // NOLINT
+#endif
+
+  mapped = nullptr;
+  mapped_size = 0;
+}
+
+namespace assets
+{
+
+auto mount(std::filesystem::path const& path) -> bool
+{
+  if(not std::filesystem::exists(path)) return false;
+
+  auto opened = AssetPack::open(path);
+
+  if(not opened) {
+    fmt::print(stderr, "{}, using loose files\n", opened.error());
+    return false;
+  }
+
+  pack = std::move(*opened);
+
+  return true;
+}
+
+auto mounted() -> bool
+{
+  return pack.has_value();
+}
+
+auto find(std::filesystem::path const& path) -> tl::optional<std::span<std::byte const>>
+{
+  if(not pack) return tl::nullopt;
+
+  auto found = pack->find(AssetPack::normalized_name(path));
+  (found ? assets_found : assets_missed).fetch_add(1, std::memory_order_relaxed);
+
+  return found;
+}
+
+auto verify() -> std::vector<std::string>
+{
+  return pack ? pack->verify() : std::vector<std::string>();
+}
+
+auto report() -> std::string
+{
+  if(not pack) return "assets: loose files\n";
+
+  return fmt::format(
+    "assets: {} in a {:.1f} MiB pack, {} found, {} missed (loaded from loose files)\n",
+    pack->assets_count(),
+    static_cast<double>(pack->size()) / (1024.0 * 1024.0),
+    assets_found.load(std::memory_order_relaxed),
+    assets_missed.load(std::memory_order_relaxed)
+  );
+}
+
+} // namespace assets
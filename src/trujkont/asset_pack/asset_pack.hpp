@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <span>
+
+#include <tl/expected.hpp>
+#include <tl/optional.hpp>
+
+// Every asset in one file, mapped into memory once (on Linux, elsewhere it's read in one go), so loading an asset is
+// a lookup handing out a view of the mapped pages: no per file opens, seeks or reads, and no copies before GL gets it.
+//
+// Layout, little endian: a 32 byte header, the index (one 40 byte entry per asset, sorted by name hash), the names
+// back to back, then the blobs, each starting at a multiple of `AssetPack::blob_alignment`. Identical blobs are stored once.
+class AssetPack
+{
+public:
+  auto inline static constexpr blob_alignment = std::size_t(64);
+
+  struct Asset
+  {
+    std::string name;
+    std::vector<std::byte> bytes;
+  };
+
+  // Names are looked up exactly as given, `normalized_name` is what both the packer and the loaders use.
+  [[nodiscard]] auto static serialize(std::span<Asset const> assets) -> std::vector<std::byte>;
+
+  [[nodiscard]] auto static normalized_name(std::filesystem::path const& path) -> std::string;
+
+  // Checks the header and the index, the blobs themselves are only read when used (or verified).
+  [[nodiscard]] auto static open(std::filesystem::path const& path) -> tl::expected<AssetPack, std::string>;
+
+  AssetPack(AssetPack const&) = delete;
+  AssetPack(AssetPack&& other) noexcept;
+  auto operator=(AssetPack const&) -> AssetPack& = delete;
+  auto operator=(AssetPack&& other) noexcept -> AssetPack&;
+
+  ~AssetPack();
+
+  // Valid for as long as the pack is.
+  [[nodiscard]] auto find(std::string_view name) const -> tl::optional<std::span<std::byte const>>;
+
+  // Names of the assets whose bytes don't hash to what the packer saw. Reads every page of the pack.
+  [[nodiscard]] auto verify() const -> std::vector<std::string>;
+
+  [[nodiscard]] auto assets_count() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+  struct Entry
+  {
+    std::uint64_t name_hash = 0;
+    std::uint64_t content_hash = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+    std::uint32_t name_offset = 0;
+    std::uint32_t name_size = 0;
+  };
+
+  AssetPack() = default;
+
+  [[nodiscard]] auto name_of(Entry const& entry) const -> std::string_view;
+
+  [[nodiscard]] auto blob_of(Entry const& entry) const -> std::span<std::byte const>;
+
+  auto release() noexcept -> void;
+
+  std::byte const* mapped = nullptr;
+  std::size_t mapped_size = 0;
+
+  // Where there is no `mmap` the whole file lives here instead.
+  std::vector<std::byte> read_bytes;
+
+  std::vector<Entry> entries;
+  std::uint64_t names_offset = 0;
+};
+
+// The pack the loaders look in before falling back to loose files. Like `program_binary`, process wide and optional.
+namespace assets
+{
+
+// False when there is no pack at `path` or it isn't a valid one (that one is reported on stderr), loose files are used then.
+auto mount(std::filesystem::path const& path) -> bool;
+
+[[nodiscard]] auto mounted() -> bool;
+
+// The asset stored under `path` (see `AssetPack::normalized_name`) in the mounted pack.
+[[nodiscard]] auto find(std::filesystem::path const& path) -> tl::optional<std::span<std::byte const>>;
+
+[[nodiscard]] auto verify() -> std::vector<std::string>;
+
+[[nodiscard]] auto report() -> std::string;
+
+} // namespace assets
@@ -0,0 +1,109 @@
+// trujkont-bake <bc1|bc3|bc7> <image> <output.tbc> [box|kaiser]
+//
+// Decodes a PNG/JPG/... image, builds its whole mip chain (gamma correct, Kaiser filtered unless asked for a box) and
+// block compresses every level into one `.tbc` container, which `Texture` then uploads without decoding or encoding anything at runtime.
+
+#include <cstring>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <span>
+
+#include "trujkont/block_compression/compressed_texture.hpp"
+#include "trujkont/block_compression/block_compression.hpp"
+#include "trujkont/mipmaps/mip_chain.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+#include <fmt/format.h>
+
+#include "stb/stb_image.h"
+
+namespace
+{
+
+auto load_image(char const* const path) -> tl::optional<MipLevel>
+{
+  auto image = MipLevel();
+  auto channels_number = 0;
+
+  auto* const data = stbi_load(path, &image.width, &image.height, &channels_number, 4);
+  if(not data) return tl::nullopt;
+
+  image.pixels.resize(static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) * 4);
+  std::memcpy(image.pixels.data(), data, image.pixels.size());
+
+  stbi_image_free(data);
+
+  return image;
+}
+
+} // namespace
+
+auto main(int const argc, char const* const* const argv) -> int
+{
+  auto const args = std::span(argv, static_cast<std::size_t>(argc));
+
+  if(args.size() != 4 and args.size() != 5) {
+    fmt::print(stderr, "usage: {} <bc1|bc3|bc7> <image> <output{}> [box|kaiser]\n", args.front(), compressed_texture_extension);
+    return 1;
+  }
+
+  auto const format = parse_block_format(args[1]);
+
+  if(not format) {
+    fmt::print(stderr, "'{}' is not one of bc1, bc3, bc7\n", args[1]);
+    return 1;
+  }
+
+  auto const filter = args.size() == 5 ? parse_mip_filter(args[4]) : tl::optional<MipFilter>(MipFilter::Kaiser);
+
+  if(not filter) {
+    fmt::print(stderr, "'{}' is not one of box, kaiser\n", args[4]);
+    return 1;
+  }
+
+  auto const image = load_image(args[2]);
+
+  if(not image) {
+    fmt::print(stderr, "Cannot decode image @ \"{}\": {}\n", args[2], stbi_failure_reason());
+    return 1;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+
+  auto jobs = JobSystem();
+  auto mips = std::vector<std::vector<std::byte>>();
+
+  auto const width = image->width;
+  auto const height = image->height;
+
+  auto const settings = MipSettings { .filter = *filter, .srgb = true, .opaque = false, .alpha_reference = tl::nullopt };
+
+  for(auto const& level : generate_mips(jobs, image->view(), settings)) {
+    mips.push_back(encode_blocks(jobs, level.view(), *format));
+  }
+
+  auto const bytes = serialize_compressed_texture(*format, width, height, mips);
+
+  auto file = std::ofstream(args[3], std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT
+
+  if(not file) {
+    fmt::print(stderr, "Cannot write \"{}\"\n", args[3]);
+    return 1;
+  }
+
+  fmt::print(
+    "{}: {}x{} {}, {} mips ({}), {} KiB in {:.1f} ms\n",
+    args[3],
+    width,
+    height,
+    block_format_name(*format),
+    mips.size(),
+    mip_filter_name(*filter),
+    bytes.size() / 1024,
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+  );
+
+  return 0;
+}
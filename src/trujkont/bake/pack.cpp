@@ -0,0 +1,88 @@
+// trujkont-pack <output.pack> <file>...
+//
+// Packs the files into one `AssetPack`, each stored under its path as given (normalized), which is the same path the
+// game asks for, e.g. `src/trujkont/shaders/cube.vert` or a baked `assets/awesomeface.tbc`. Run from the repository root.
+
+#include <filesystem>
+#include <system_error>
+#include <stdexcept>
+#include <fstream>
+#include <vector>
+#include <span>
+
+#include "trujkont/asset_pack/asset_pack.hpp"
+
+#include <fmt/format.h>
+
+auto main(int const argc, char const* const* const argv) -> int
+{
+  auto const args = std::span(argv, static_cast<std::size_t>(argc));
+
+  if(args.size() < 3) {
+    fmt::print(stderr, "usage: {} <output.pack> <file>...\n", args.front());
+    return 1;
+  }
+
+  auto assets = std::vector<AssetPack::Asset>();
+  auto unpacked_size = std::size_t(0);
+
+  for(auto const* const path : args.subspan(2)) {
+    auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+
+    if(not file) {
+      fmt::print(stderr, "Cannot find \"{}\"\n", path);
+      return 1;
+    }
+
+    auto asset = AssetPack::Asset { .name = AssetPack::normalized_name(path), .bytes = {} };
+    asset.bytes.resize(static_cast<std::size_t>(file.tellg()));
+
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(asset.bytes.data()), static_cast<std::streamsize>(asset.bytes.size())); // NOLINT
+
+    if(not file) {
+      fmt::print(stderr, "Cannot read \"{}\"\n", path);
+      return 1;
+    }
+
+    unpacked_size += asset.bytes.size();
+    assets.push_back(std::move(asset));
+  }
+
+  auto bytes = std::vector<std::byte>();
+
+  try {
+    bytes = AssetPack::serialize(assets);
+  } catch(std::invalid_argument const& error) {
+    fmt::print(stderr, "{}\n", error.what());
+    return 1;
+  }
+
+  // Written next to the final file and renamed over it, a running game may have the old one mapped.
+  auto const output = std::filesystem::path(args[1]);
+  auto temporary_output = output;
+  temporary_output += ".tmp";
+
+  {
+    auto file = std::ofstream(temporary_output, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT
+
+    if(not file) {
+      fmt::print(stderr, "Cannot write \"{}\"\n", temporary_output.c_str());
+      return 1;
+    }
+  }
+
+  auto error = std::error_code();
+  std::filesystem::rename(temporary_output, output, error);
+
+  if(error) {
+    fmt::print(stderr, "Cannot replace \"{}\": {}\n", output.c_str(), error.message());
+    std::filesystem::remove(temporary_output, error);
+    return 1;
+  }
+
+  fmt::print("{}: {} assets, {} KiB ({} KiB unpacked)\n", output.c_str(), assets.size(), bytes.size() / 1024, unpacked_size / 1024);
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+// Milliseconds of the fastest of `runs` calls, the least disturbed by the scheduler, caches warming up and the like.
+template<typename Callable>
+[[nodiscard]] auto best_time(int const runs, Callable&& callable) -> double
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto best = std::chrono::duration<double, std::milli>::max();
+
+  for(auto run = 0; run < runs; ++run) {
+    auto const start = Clock::now();
+    callable();
+    best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start));
+  }
+
+  return best.count();
+}
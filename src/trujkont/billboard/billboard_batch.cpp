@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <array>
+
+#include "trujkont/billboard/billboard_batch.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto load_billboard_program()
+{
+  auto const stages = std::array {
+    program_cache::StageFile { ShaderType::Vertex, "src/trujkont/shaders/billboard.vert" },
+    program_cache::StageFile { ShaderType::Fragment, "src/trujkont/shaders/billboard.frag" }
+  };
+
+  auto program = program_cache::load_async(stages);
+  if(not program) {
+    fmt::print(stderr, "{}", program.error());
+    throw std::runtime_error("Cannot load billboard shader program!");
+  }
+
+  return *std::move(program);
+}
+
+} // namespace
+
+BillboardBatch::BillboardBatch()
+  : shader_program(load_billboard_program())
+{
+  gl_state::bind_vertex_array(quad.vertex_array());
+
+  for(auto const location : { position_size_attr_location, layer_attr_location, tint_attr_location, region_attr_location }) {
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
+  }
+}
+
+auto BillboardBatch::draw(StreamBuffer& stream, std::span<BillboardSprite const> const sprites, TextureSlot const textures) -> void
+{
+  auto const* const program = shader_program->current();
+  if(sprites.empty() or not program) return;
+
+  if(shader_program->generation() != shader_program_generation) {
+    shader_program_generation = shader_program->generation();
+    textures_uniform = program->uniform<int>("billboard_textures");
+  }
+
+  auto instances = stream.allocate<BillboardSprite>(sprites.size());
+  if(not instances) return;
+
+  std::ranges::copy(sprites, instances->data.begin());
+
+  textures_uniform.set(static_cast<int>(textures));
+  program->use();
+
+  gl_state::bind_vertex_array(quad.vertex_array());
+  point_instances_at(stream.id(), instances->offset);
+
+  // The pooled images have their alpha premultiplied, the rest of the scene blends straight alpha.
+  gl_state::blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  quad.draw_instanced(static_cast<GLsizei>(sprites.size()));
+  gl_state::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+auto BillboardBatch::point_instances_at(GLuint const instance_buffer, GLintptr const instances_offset) -> void
+{
+  if(instance_buffer == instances_source and instances_offset == instances_source_offset) return;
+
+  instances_source = instance_buffer;
+  instances_source_offset = instances_offset;
+
+  gl_state::bind_buffer(GL_ARRAY_BUFFER, instance_buffer);
+
+  auto const member = [instances_offset](std::size_t const member_offset) {
+    return reinterpret_cast<void*>(static_cast<std::size_t>(instances_offset) + member_offset); // NOLINT
+  };
+
+  auto constexpr stride = static_cast<GLsizei>(sizeof(BillboardSprite));
+
+  // The size rides along in the position's fourth component.
+  glVertexAttribPointer(position_size_attr_location, 4, GL_FLOAT, GL_FALSE, stride, member(offsetof(BillboardSprite, position)));
+  glVertexAttribIPointer(layer_attr_location, 1, GL_UNSIGNED_INT, stride, member(offsetof(BillboardSprite, layer)));
+  glVertexAttribPointer(tint_attr_location, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, member(offsetof(BillboardSprite, tint)));
+
+  // Both corners of the region as one vec4.
+  glVertexAttribPointer(region_attr_location, 4, GL_FLOAT, GL_FALSE, stride, member(offsetof(BillboardSprite, region)));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include <glad/glad.h>
+
+#include "trujkont/billboard/billboard_sprite.hpp"
+#include "trujkont/shader_program/program_cache.hpp"
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+#include "trujkont/texture/texture.hpp"
+#include "trujkont/quad/quad.hpp"
+
+// Draws any number of billboards with a single instanced draw call.
+// The quad is turned towards the camera in the vertex shader, so each billboard is nothing but its `BillboardSprite`.
+class BillboardBatch
+{
+public:
+  BillboardBatch();
+
+  // Copies `sprites` into the frame's streaming region and draws them, sampling the texture array at `textures`,
+  // which holds premultiplied alpha like `TextureArrayPool` and `TextureAtlas` store it.
+  // Draws nothing when the region has no room left.
+  auto draw(StreamBuffer& stream, std::span<BillboardSprite const> sprites, TextureSlot textures) -> void;
+
+private:
+  auto point_instances_at(GLuint instance_buffer, GLintptr instances_offset) -> void;
+
+  Quad quad;
+
+  // Until it's linked, billboards are not drawn.
+  program_cache::AsyncProgramHandle shader_program;
+  std::uint64_t shader_program_generation = 0;
+
+  Uniform<int> textures_uniform;
+
+  // Where the instance attributes currently point, re-pointing them is only needed when the allocation moved.
+  GLuint instances_source = 0;
+  GLintptr instances_source_offset = -1;
+
+  auto inline static constexpr position_size_attr_location = Quad::first_free_attr_location;
+  auto inline static constexpr layer_attr_location = Quad::first_free_attr_location + 1;
+  auto inline static constexpr tint_attr_location = Quad::first_free_attr_location + 2;
+  auto inline static constexpr region_attr_location = Quad::first_free_attr_location + 3;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "trujkont/texture/atlas_region.hpp"
+
+// One camera facing textured quad, laid out exactly like the per instance data `BillboardBatch` feeds the GPU.
+struct BillboardSprite
+{
+  glm::vec3 position = glm::vec3(0.);
+
+  // Of the square's side, in world units.
+  float size = 1.0F;
+
+  // Into the texture array the batch is drawn with.
+  std::uint32_t layer = 0;
+
+  // RGBA, multiplied with the texture.
+  std::array<std::uint8_t, 4> tint = { 255, 255, 255, 255 };
+
+  // Of the layer, for sprites packed into a `TextureAtlas`. The whole layer by default.
+  AtlasRegion region;
+};
+
+static_assert(sizeof(BillboardSprite) == 40, "BillboardSprite is uploaded as is, its layout must match the instance attributes");
@@ -0,0 +1,636 @@
+#pragma once
+
+#include "trujkont/block_compression/bc_kernels.hpp"
+#include "trujkont/simd/simd_float.hpp"
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+// `Channels` consecutive channels of a pixel, an endpoint or a direction.
+template<std::size_t Channels>
+struct Color
+{
+  float values[Channels] = {}; // NOLINT(*-avoid-c-arrays)
+};
+
+template<std::size_t Channels>
+struct Endpoints
+{
+  Color<Channels> from;
+  Color<Channels> to;
+};
+
+auto constexpr no_distance = 1e30F;
+
+auto clamp_channel(float const value) -> float
+{
+  return value < 0.0F ? 0.0F : (value > 255.0F ? 255.0F : value); // NOLINT(*-magic-numbers)
+}
+
+auto absolute(float const value) -> float
+{
+  return value < 0.0F ? -value : value;
+}
+
+// Of non negative values only, <cmath> is off limits in here (see simd_float.hpp).
+auto round_to_int(float const value) -> int
+{
+  return static_cast<int>(value + 0.5F);
+}
+
+template<std::size_t Channels>
+auto dot(Color<Channels> const& a, Color<Channels> const& b) -> float
+{
+  auto result = 0.0F;
+  for(auto c = std::size_t(0); c < Channels; ++c) result += a.values[c] * b.values[c];
+
+  return result;
+}
+
+template<typename V>
+auto sum_lanes(typename V::Float const value) -> float
+{
+  float lanes[V::width]; // NOLINT(*-avoid-c-arrays)
+  V::store(lanes, value);
+
+  auto sum = 0.0F;
+  for(auto const lane : lanes) sum += lane;
+
+  return sum;
+}
+
+template<typename V>
+auto min_lane(typename V::Float const value) -> float
+{
+  float lanes[V::width]; // NOLINT(*-avoid-c-arrays)
+  V::store(lanes, value);
+
+  auto lowest = lanes[0];
+  for(auto const lane : lanes) lowest = lane < lowest ? lane : lowest;
+
+  return lowest;
+}
+
+template<typename V>
+auto max_lane(typename V::Float const value) -> float
+{
+  float lanes[V::width]; // NOLINT(*-avoid-c-arrays)
+  V::store(lanes, value);
+
+  auto highest = lanes[0];
+  for(auto const lane : lanes) highest = lane > highest ? lane : highest;
+
+  return highest;
+}
+
+// Channels [First, First + Channels) of the block projected onto `axis`, relative to `origin`.
+template<typename V, std::size_t First, std::size_t Channels>
+auto project(BlockPixels const& block, std::size_t const first_pixel, Color<Channels> const& origin, Color<Channels> const& axis) -> typename V::Float
+{
+  auto projection = V::set1(0.0F);
+
+  for(auto c = std::size_t(0); c < Channels; ++c) {
+    auto const centered = V::sub(V::load(block.channels[First + c] + first_pixel), V::set1(origin.values[c]));
+    projection = V::fmadd(centered, V::set1(axis.values[c]), projection);
+  }
+
+  return projection;
+}
+
+template<typename V, std::size_t First, std::size_t Channels>
+auto mean_of(BlockPixels const& block) -> Color<Channels>
+{
+  auto mean = Color<Channels>();
+
+  for(auto c = std::size_t(0); c < Channels; ++c) {
+    auto sum = V::set1(0.0F);
+
+    for(auto i = std::size_t(0); i < block_pixels_count; i += V::width) {
+      sum = V::add(sum, V::load(block.channels[First + c] + i));
+    }
+
+    mean.values[c] = sum_lanes<V>(sum) / static_cast<float>(block_pixels_count);
+  }
+
+  return mean;
+}
+
+// The direction the block's colors vary the most along, by power iteration on their covariance.
+// Not normalized, zero for a flat block.
+template<typename V, std::size_t First, std::size_t Channels>
+auto principal_axis(BlockPixels const& block, Color<Channels> const& mean) -> Color<Channels>
+{
+  typename V::Float sums[Channels][Channels]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto row = std::size_t(0); row < Channels; ++row) {
+    for(auto column = std::size_t(0); column < Channels; ++column) sums[row][column] = V::set1(0.0F);
+  }
+
+  for(auto i = std::size_t(0); i < block_pixels_count; i += V::width) {
+    typename V::Float centered[Channels]; // NOLINT(*-avoid-c-arrays)
+
+    for(auto c = std::size_t(0); c < Channels; ++c) {
+      centered[c] = V::sub(V::load(block.channels[First + c] + i), V::set1(mean.values[c]));
+    }
+
+    for(auto row = std::size_t(0); row < Channels; ++row) {
+      for(auto column = row; column < Channels; ++column) {
+        sums[row][column] = V::fmadd(centered[row], centered[column], sums[row][column]);
+      }
+    }
+  }
+
+  float covariance[Channels][Channels]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto row = std::size_t(0); row < Channels; ++row) {
+    for(auto column = row; column < Channels; ++column) {
+      covariance[row][column] = sum_lanes<V>(sums[row][column]);
+      covariance[column][row] = covariance[row][column];
+    }
+  }
+
+  // Starting from the channel that varies the most makes a start orthogonal to the axis next to impossible.
+  auto widest = std::size_t(0);
+  for(auto c = std::size_t(1); c < Channels; ++c) {
+    if(covariance[c][c] > covariance[widest][widest]) widest = c;
+  }
+
+  auto axis = Color<Channels>();
+  if(covariance[widest][widest] < 1e-3F) return axis; // NOLINT(*-magic-numbers)
+
+  for(auto c = std::size_t(0); c < Channels; ++c) axis.values[c] = covariance[c][widest];
+
+  auto constexpr iterations = 8;
+
+  for(auto iteration = 0; iteration < iterations; ++iteration) {
+    auto next = Color<Channels>();
+    auto largest = 0.0F;
+
+    for(auto row = std::size_t(0); row < Channels; ++row) {
+      for(auto column = std::size_t(0); column < Channels; ++column) next.values[row] += covariance[row][column] * axis.values[column];
+
+      largest = absolute(next.values[row]) > largest ? absolute(next.values[row]) : largest;
+    }
+
+    if(largest <= 0.0F) break;
+
+    // Only the direction matters, scaling by the largest component keeps the values in range without a square root.
+    for(auto c = std::size_t(0); c < Channels; ++c) axis.values[c] = next.values[c] / largest;
+  }
+
+  return axis;
+}
+
+// The extremes of the block along its principal axis.
+template<typename V, std::size_t First, std::size_t Channels>
+auto principal_endpoints(BlockPixels const& block) -> Endpoints<Channels>
+{
+  auto const mean = mean_of<V, First, Channels>(block);
+  auto const axis = principal_axis<V, First, Channels>(block, mean);
+
+  auto const length_squared = dot(axis, axis);
+  if(length_squared <= 0.0F) return Endpoints<Channels> { .from = mean, .to = mean };
+
+  auto lowest = V::set1(no_distance);
+  auto highest = V::set1(-no_distance);
+
+  for(auto i = std::size_t(0); i < block_pixels_count; i += V::width) {
+    auto const projection = project<V, First, Channels>(block, i, mean, axis);
+
+    lowest = V::min(lowest, projection);
+    highest = V::max(highest, projection);
+  }
+
+  auto const from = min_lane<V>(lowest) / length_squared;
+  auto const to = max_lane<V>(highest) / length_squared;
+
+  auto endpoints = Endpoints<Channels>();
+
+  for(auto c = std::size_t(0); c < Channels; ++c) {
+    endpoints.from.values[c] = clamp_channel(mean.values[c] + axis.values[c] * from);
+    endpoints.to.values[c] = clamp_channel(mean.values[c] + axis.values[c] * to);
+  }
+
+  return endpoints;
+}
+
+// For every pixel, the nearest of `steps + 1` evenly spaced points from `endpoints.from` (step 0) to `endpoints.to`.
+template<typename V, std::size_t First, std::size_t Channels>
+auto fit_steps(BlockPixels const& block, Endpoints<Channels> const& endpoints, float const steps, std::uint8_t* const out) -> void
+{
+  auto direction = Color<Channels>();
+  for(auto c = std::size_t(0); c < Channels; ++c) direction.values[c] = endpoints.to.values[c] - endpoints.from.values[c];
+
+  auto const length_squared = dot(direction, direction);
+
+  if(length_squared <= 0.0F) {
+    for(auto i = std::size_t(0); i < block_pixels_count; ++i) out[i] = 0;
+    return;
+  }
+
+  auto const scale = V::set1(steps / length_squared);
+
+  for(auto i = std::size_t(0); i < block_pixels_count; i += V::width) {
+    auto const projection = project<V, First, Channels>(block, i, endpoints.from, direction);
+    auto const nearest = V::min(V::max(V::fmadd(projection, scale, V::set1(0.5F)), V::set1(0.0F)), V::set1(steps));
+
+    float stepped[V::width]; // NOLINT(*-avoid-c-arrays)
+    V::store(stepped, V::to_float(V::truncate(nearest)));
+
+    for(auto lane = std::size_t(0); lane < V::width; ++lane) out[i + lane] = static_cast<std::uint8_t>(stepped[lane]);
+  }
+}
+
+template<std::size_t First, std::size_t Channels>
+auto squared_error(BlockPixels const& block, Color<Channels> const* const palette, std::uint8_t const* const steps) -> float
+{
+  auto error = 0.0F;
+
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) {
+    for(auto c = std::size_t(0); c < Channels; ++c) {
+      auto const difference = block.channels[First + c][i] - palette[steps[i]].values[c];
+      error += difference * difference;
+    }
+  }
+
+  return error;
+}
+
+// Least squares endpoints for pixels already assigned to the points `weights[step]` of the way between them.
+// Leaves `endpoints` alone and returns false when every pixel got the same weight, the system has no single solution then.
+template<std::size_t First, std::size_t Channels>
+auto refit_endpoints(BlockPixels const& block, std::uint8_t const* const steps, float const* const weights, Endpoints<Channels>& endpoints) -> bool
+{
+  auto from_from = 0.0F;
+  auto from_to = 0.0F;
+  auto to_to = 0.0F;
+
+  auto from_sums = Color<Channels>();
+  auto to_sums = Color<Channels>();
+
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) {
+    auto const to_weight = weights[steps[i]];
+    auto const from_weight = 1.0F - to_weight;
+
+    from_from += from_weight * from_weight;
+    from_to += from_weight * to_weight;
+    to_to += to_weight * to_weight;
+
+    for(auto c = std::size_t(0); c < Channels; ++c) {
+      from_sums.values[c] += from_weight * block.channels[First + c][i];
+      to_sums.values[c] += to_weight * block.channels[First + c][i];
+    }
+  }
+
+  auto const determinant = from_from * to_to - from_to * from_to;
+  if(determinant < 1e-6F) return false; // NOLINT(*-magic-numbers)
+
+  for(auto c = std::size_t(0); c < Channels; ++c) {
+    endpoints.from.values[c] = clamp_channel((to_to * from_sums.values[c] - from_to * to_sums.values[c]) / determinant);
+    endpoints.to.values[c] = clamp_channel((from_from * to_sums.values[c] - from_to * from_sums.values[c]) / determinant);
+  }
+
+  return true;
+}
+
+// BC1 colors, also the color half of BC3.
+
+auto constexpr color_steps = 3;
+float constexpr color_weights[] = { 0.0F, 1.0F / 3.0F, 2.0F / 3.0F, 1.0F }; // NOLINT(*-avoid-c-arrays)
+
+// Step from color0 towards color1 to the index stored for it.
+std::uint8_t constexpr color_indices[] = { 0, 2, 3, 1 }; // NOLINT(*-avoid-c-arrays)
+
+struct ColorBlock
+{
+  std::uint16_t color0 = 0;
+  std::uint16_t color1 = 0;
+  std::uint8_t steps[block_pixels_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float error = 0.0F;
+};
+
+auto to_565(Color<3> const& color) -> std::uint16_t
+{
+  auto const r = round_to_int(color.values[0] * 31.0F / 255.0F); // NOLINT(*-magic-numbers)
+  auto const g = round_to_int(color.values[1] * 63.0F / 255.0F); // NOLINT(*-magic-numbers)
+  auto const b = round_to_int(color.values[2] * 31.0F / 255.0F); // NOLINT(*-magic-numbers)
+
+  return static_cast<std::uint16_t>((r << 11) | (g << 5) | b); // NOLINT(*-magic-numbers)
+}
+
+auto from_565(std::uint16_t const color) -> Color<3>
+{
+  auto const r = (color >> 11U) & 31U; // NOLINT(*-magic-numbers)
+  auto const g = (color >> 5U) & 63U; // NOLINT(*-magic-numbers)
+  auto const b = color & 31U; // NOLINT(*-magic-numbers)
+
+  return Color<3> { .values = {
+    static_cast<float>((r << 3U) | (r >> 2U)),
+    static_cast<float>((g << 2U) | (g >> 4U)),
+    static_cast<float>((b << 3U) | (b >> 2U)),
+  } };
+}
+
+// Two thirds of `near` and one of `far`, rounded down like the decoders do.
+auto color_third(Color<3> const& near, Color<3> const& far) -> Color<3>
+{
+  auto third = Color<3>();
+
+  for(auto c = std::size_t(0); c < 3; ++c) {
+    third.values[c] = static_cast<float>(static_cast<int>(2.0F * near.values[c] + far.values[c]) / 3);
+  }
+
+  return third;
+}
+
+template<typename V>
+auto try_color_endpoints(BlockPixels const& block, Endpoints<3> const& endpoints) -> ColorBlock
+{
+  auto result = ColorBlock();
+  result.color0 = to_565(endpoints.from);
+  result.color1 = to_565(endpoints.to);
+
+  // Only color0 > color1 gets four colors, the other way around BC1 has three and transparent black.
+  if(result.color0 < result.color1) {
+    auto const color0 = result.color0;
+    result.color0 = result.color1;
+    result.color1 = color0;
+  }
+
+  auto const first = from_565(result.color0);
+  auto const last = from_565(result.color1);
+
+  Color<3> const palette[] = { first, color_third(first, last), color_third(last, first), last }; // NOLINT(*-avoid-c-arrays)
+
+  // Equal colors leave every pixel at step 0, which is color0 in either mode.
+  if(result.color0 != result.color1) {
+    fit_steps<V, 0, 3>(block, Endpoints<3> { .from = first, .to = last }, color_steps, result.steps);
+  }
+
+  result.error = squared_error<0, 3>(block, palette, result.steps);
+
+  return result;
+}
+
+template<typename V>
+auto encode_color_block(BlockPixels const& block, std::uint8_t* const out) -> void
+{
+  auto endpoints = principal_endpoints<V, 0, 3>(block);
+  auto best = try_color_endpoints<V>(block, endpoints);
+
+  // The extremes are skewed by outliers, one round of least squares on their assignment moves them towards the clusters.
+  if(best.error > 0.0F and refit_endpoints<0, 3>(block, best.steps, color_weights, endpoints)) {
+    auto const refined = try_color_endpoints<V>(block, endpoints);
+    if(refined.error < best.error) best = refined;
+  }
+
+  auto indices = std::uint32_t(0);
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) indices |= std::uint32_t(color_indices[best.steps[i]]) << (2 * i);
+
+  out[0] = static_cast<std::uint8_t>(best.color0);
+  out[1] = static_cast<std::uint8_t>(best.color0 >> 8U); // NOLINT(*-magic-numbers)
+  out[2] = static_cast<std::uint8_t>(best.color1);
+  out[3] = static_cast<std::uint8_t>(best.color1 >> 8U); // NOLINT(*-magic-numbers)
+
+  for(auto byte = std::size_t(0); byte < 4; ++byte) out[4 + byte] = static_cast<std::uint8_t>(indices >> (8 * byte));
+}
+
+// BC3 alpha.
+
+auto constexpr alpha_steps = 7;
+float constexpr alpha_weights[] = { 0.0F, 1.0F / 7, 2.0F / 7, 3.0F / 7, 4.0F / 7, 5.0F / 7, 6.0F / 7, 1.0F }; // NOLINT
+
+struct AlphaBlock
+{
+  std::uint8_t alpha0 = 0;
+  std::uint8_t alpha1 = 0;
+  std::uint8_t steps[block_pixels_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float error = 0.0F;
+};
+
+// Step from alpha0 towards alpha1 to the index stored for it, the endpoints come first.
+auto alpha_index(std::uint8_t const step) -> std::uint64_t
+{
+  return step == 0 ? 0 : (step == alpha_steps ? 1 : step + 1U);
+}
+
+template<typename V>
+auto try_alpha_endpoints(BlockPixels const& block, Endpoints<1> const& endpoints) -> AlphaBlock
+{
+  auto result = AlphaBlock();
+  result.alpha0 = static_cast<std::uint8_t>(round_to_int(endpoints.from.values[0]));
+  result.alpha1 = static_cast<std::uint8_t>(round_to_int(endpoints.to.values[0]));
+
+  // Only alpha0 > alpha1 gets eight evenly spaced values, the other way around there are six and both extremes.
+  if(result.alpha0 < result.alpha1) {
+    auto const alpha0 = result.alpha0;
+    result.alpha0 = result.alpha1;
+    result.alpha1 = alpha0;
+  }
+
+  Color<1> palette[alpha_steps + 1]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto step = 0; step <= alpha_steps; ++step) {
+    palette[step].values[0] = static_cast<float>(((alpha_steps - step) * result.alpha0 + step * result.alpha1) / alpha_steps);
+  }
+
+  if(result.alpha0 != result.alpha1) {
+    auto const ordered = Endpoints<1> { .from = palette[0], .to = palette[alpha_steps] };
+    fit_steps<V, 3, 1>(block, ordered, alpha_steps, result.steps);
+  }
+
+  result.error = squared_error<3, 1>(block, palette, result.steps);
+
+  return result;
+}
+
+template<typename V>
+auto encode_alpha_block(BlockPixels const& block, std::uint8_t* const out) -> void
+{
+  auto endpoints = principal_endpoints<V, 3, 1>(block);
+  auto best = try_alpha_endpoints<V>(block, endpoints);
+
+  if(best.error > 0.0F and refit_endpoints<3, 1>(block, best.steps, alpha_weights, endpoints)) {
+    auto const refined = try_alpha_endpoints<V>(block, endpoints);
+    if(refined.error < best.error) best = refined;
+  }
+
+  auto indices = std::uint64_t(0);
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) indices |= alpha_index(best.steps[i]) << (3 * i);
+
+  out[0] = best.alpha0;
+  out[1] = best.alpha1;
+
+  for(auto byte = std::size_t(0); byte < 6; ++byte) out[2 + byte] = static_cast<std::uint8_t>(indices >> (8 * byte));
+}
+
+// BC7, mode 6 only.
+
+auto constexpr bc7_steps = 15;
+int constexpr bc7_weights[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 }; // NOLINT
+
+float constexpr bc7_float_weights[] = { // NOLINT(*-avoid-c-arrays)
+  0.0F / 64, 4.0F / 64, 9.0F / 64, 13.0F / 64, 17.0F / 64, 21.0F / 64, 26.0F / 64, 30.0F / 64,
+  34.0F / 64, 38.0F / 64, 43.0F / 64, 47.0F / 64, 51.0F / 64, 55.0F / 64, 60.0F / 64, 64.0F / 64,
+};
+
+// Seven bits per channel and one p-bit, shared by all four, as the lowest bit of each.
+struct Bc7Endpoint
+{
+  std::uint8_t values[4] = {}; // NOLINT(*-avoid-c-arrays)
+  std::uint8_t p_bit = 0;
+};
+
+struct Bc7Block
+{
+  Bc7Endpoint first;
+  Bc7Endpoint last;
+  std::uint8_t steps[block_pixels_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float error = 0.0F;
+};
+
+auto decode_bc7_endpoint(Bc7Endpoint const& endpoint) -> Color<4>
+{
+  auto color = Color<4>();
+  for(auto c = std::size_t(0); c < 4; ++c) color.values[c] = static_cast<float>((endpoint.values[c] << 1U) | endpoint.p_bit);
+
+  return color;
+}
+
+// The p-bit moves all four channels at once, so both are tried.
+auto quantize_bc7_endpoint(Color<4> const& color) -> Bc7Endpoint
+{
+  auto best = Bc7Endpoint();
+  auto best_error = no_distance;
+
+  for(auto p_bit = std::uint8_t(0); p_bit < 2; ++p_bit) {
+    auto candidate = Bc7Endpoint { .values = {}, .p_bit = p_bit };
+    auto error = 0.0F;
+
+    for(auto c = std::size_t(0); c < 4; ++c) {
+      auto const half = (color.values[c] - static_cast<float>(p_bit)) * 0.5F;
+      candidate.values[c] = static_cast<std::uint8_t>(round_to_int(half < 0.0F ? 0.0F : (half > 127.0F ? 127.0F : half))); // NOLINT
+
+      auto const difference = static_cast<float>((candidate.values[c] << 1U) | p_bit) - color.values[c];
+      error += difference * difference;
+    }
+
+    if(error < best_error) {
+      best = candidate;
+      best_error = error;
+    }
+  }
+
+  return best;
+}
+
+template<typename V>
+auto try_bc7_endpoints(BlockPixels const& block, Endpoints<4> const& endpoints) -> Bc7Block
+{
+  auto result = Bc7Block();
+  result.first = quantize_bc7_endpoint(endpoints.from);
+  result.last = quantize_bc7_endpoint(endpoints.to);
+
+  auto const first = decode_bc7_endpoint(result.first);
+  auto const last = decode_bc7_endpoint(result.last);
+
+  Color<4> palette[bc7_steps + 1]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto step = 0; step <= bc7_steps; ++step) {
+    auto const weight = bc7_weights[step];
+
+    for(auto c = std::size_t(0); c < 4; ++c) {
+      auto const value = (64 - weight) * static_cast<int>(first.values[c]) + weight * static_cast<int>(last.values[c]) + 32; // NOLINT
+      palette[step].values[c] = static_cast<float>(value >> 6); // NOLINT(*-magic-numbers)
+    }
+  }
+
+  fit_steps<V, 0, 4>(block, Endpoints<4> { .from = first, .to = last }, bc7_steps, result.steps);
+
+  result.error = squared_error<0, 4>(block, palette, result.steps);
+
+  // The first index is stored without its top bit, so it has to be in the lower half. The weights are symmetric,
+  // so swapping the endpoints and mirroring every index gets it there without changing a single decoded pixel.
+  if(result.steps[0] > bc7_steps / 2) {
+    auto const endpoint = result.first;
+    result.first = result.last;
+    result.last = endpoint;
+
+    for(auto& step : result.steps) step = static_cast<std::uint8_t>(bc7_steps - step);
+  }
+
+  return result;
+}
+
+// Little endian bit stream of a 128 bit block, filled from the lowest bit up.
+struct BlockBits
+{
+  std::uint64_t words[2] = {}; // NOLINT(*-avoid-c-arrays)
+  unsigned position = 0;
+
+  auto put(unsigned const value, unsigned const bits) -> void
+  {
+    for(auto bit = 0U; bit < bits; ++bit, ++position) {
+      words[position / 64] |= std::uint64_t((value >> bit) & 1U) << (position % 64); // NOLINT(*-magic-numbers)
+    }
+  }
+
+  auto write(std::uint8_t* const out) const -> void
+  {
+    for(auto byte = std::size_t(0); byte < 16; ++byte) out[byte] = static_cast<std::uint8_t>(words[byte / 8] >> (8 * (byte % 8))); // NOLINT
+  }
+};
+
+template<typename V>
+auto encode_bc7_block(BlockPixels const& block, std::uint8_t* const out) -> void
+{
+  auto endpoints = principal_endpoints<V, 0, 4>(block);
+  auto best = try_bc7_endpoints<V>(block, endpoints);
+
+  // Mirrored or not, step 0 is still at `first`, the refit only cares that the weights match the endpoints.
+  if(best.error > 0.0F and refit_endpoints<0, 4>(block, best.steps, bc7_float_weights, endpoints)) {
+    auto const refined = try_bc7_endpoints<V>(block, endpoints);
+    if(refined.error < best.error) best = refined;
+  }
+
+  auto bits = BlockBits();
+
+  // Mode 6 is a one after six zeros.
+  bits.put(1U << 6U, 7); // NOLINT(*-magic-numbers)
+
+  for(auto c = std::size_t(0); c < 4; ++c) {
+    bits.put(best.first.values[c], 7); // NOLINT(*-magic-numbers)
+    bits.put(best.last.values[c], 7); // NOLINT(*-magic-numbers)
+  }
+
+  bits.put(best.first.p_bit, 1);
+  bits.put(best.last.p_bit, 1);
+
+  bits.put(best.steps[0], 3);
+  for(auto i = std::size_t(1); i < block_pixels_count; ++i) bits.put(best.steps[i], 4);
+
+  bits.write(out);
+}
+
+template<typename V>
+auto encode_bc1(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  for(auto i = std::size_t(0); i < count; ++i) encode_color_block<V>(blocks[i], out + 8 * i);
+}
+
+template<typename V>
+auto encode_bc3(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  for(auto i = std::size_t(0); i < count; ++i) {
+    encode_alpha_block<V>(blocks[i], out + 16 * i);
+    encode_color_block<V>(blocks[i], out + 16 * i + 8);
+  }
+}
+
+template<typename V>
+auto encode_bc7(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  for(auto i = std::size_t(0); i < count; ++i) encode_bc7_block<V>(blocks[i], out + 16 * i);
+}
+
+} // namespace
@@ -0,0 +1,67 @@
+#include "trujkont/block_compression/bc_kernel_impl.hpp"
+
+namespace bc_kernels
+{
+
+auto encode_bc1_scalar(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc1<ScalarFloats>(blocks, count, out);
+}
+
+auto encode_bc1_sse(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  encode_bc1<SseFloats>(blocks, count, out);
+#else
+  encode_bc1<ScalarFloats>(blocks, count, out);
+#endif
+}
+
+auto encode_bc3_scalar(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc3<ScalarFloats>(blocks, count, out);
+}
+
+auto encode_bc3_sse(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  encode_bc3<SseFloats>(blocks, count, out);
+#else
+  encode_bc3<ScalarFloats>(blocks, count, out);
+#endif
+}
+
+auto encode_bc7_scalar(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc7<ScalarFloats>(blocks, count, out);
+}
+
+auto encode_bc7_sse(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  encode_bc7<SseFloats>(blocks, count, out);
+#else
+  encode_bc7<ScalarFloats>(blocks, count, out);
+#endif
+}
+
+#if not defined(TRUJKONT_AVX2_KERNELS)
+
+auto encode_bc1_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc1_sse(blocks, count, out);
+}
+
+auto encode_bc3_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc3_sse(blocks, count, out);
+}
+
+auto encode_bc7_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc7_sse(blocks, count, out);
+}
+
+#endif
+
+} // namespace bc_kernels
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+auto inline constexpr block_pixels_count = std::size_t(16);
+
+// One 4x4 block, one array per channel (r, g, b, a) of values in [0, 255], pixels row by row.
+// Kept free of standard library types for the same reason `TransformArrays` is.
+struct BlockPixels
+{
+  float channels[4][block_pixels_count] = {}; // NOLINT(*-avoid-c-arrays)
+};
+
+// Each encodes `count` blocks to `out`, back to back: 8 bytes per BC1 block, 16 per BC3 and BC7 block.
+// BC1 ignores alpha, BC7 only ever writes mode 6 blocks (one subset, RGBA endpoints with a p-bit, 4 bit indices).
+namespace bc_kernels
+{
+
+auto encode_bc1_scalar(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc1_sse(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc1_avx2(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc3_scalar(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc3_sse(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc3_avx2(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc7_scalar(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc7_sse(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+auto encode_bc7_avx2(BlockPixels const* blocks, std::size_t count, std::uint8_t* out) -> void;
+
+} // namespace bc_kernels
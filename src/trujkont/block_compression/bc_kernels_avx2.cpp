@@ -0,0 +1,22 @@
+#include "trujkont/simd/simd_float_avx2.hpp"
+#include "trujkont/block_compression/bc_kernel_impl.hpp"
+
+namespace bc_kernels
+{
+
+auto encode_bc1_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc1<Avx2Floats>(blocks, count, out);
+}
+
+auto encode_bc3_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc3<Avx2Floats>(blocks, count, out);
+}
+
+auto encode_bc7_avx2(BlockPixels const* const blocks, std::size_t const count, std::uint8_t* const out) -> void
+{
+  encode_bc7<Avx2Floats>(blocks, count, out);
+}
+
+} // namespace bc_kernels
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <stdexcept>
+#include <array>
+
+#include "trujkont/block_compression/block_compression.hpp"
+#include "trujkont/block_compression/bc_kernels.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+using EncodeKernel = auto (*)(BlockPixels const*, std::size_t, std::uint8_t*) -> void;
+
+auto kernel_for(BlockFormat const format, SimdLevel const level) -> EncodeKernel
+{
+  switch(format) {
+    case BlockFormat::Bc1:
+      switch(level) {
+        case SimdLevel::Scalar: return bc_kernels::encode_bc1_scalar;
+        case SimdLevel::Sse: return bc_kernels::encode_bc1_sse;
+        case SimdLevel::Avx2: return bc_kernels::encode_bc1_avx2;
+      }
+      break;
+
+    case BlockFormat::Bc3:
+      switch(level) {
+        case SimdLevel::Scalar: return bc_kernels::encode_bc3_scalar;
+        case SimdLevel::Sse: return bc_kernels::encode_bc3_sse;
+        case SimdLevel::Avx2: return bc_kernels::encode_bc3_avx2;
+      }
+      break;
+
+    case BlockFormat::Bc7:
+      switch(level) {
+        case SimdLevel::Scalar: return bc_kernels::encode_bc7_scalar;
+        case SimdLevel::Sse: return bc_kernels::encode_bc7_sse;
+        case SimdLevel::Avx2: return bc_kernels::encode_bc7_avx2;
+      }
+      break;
+  }
+
+  throw std::invalid_argument(fmt::format("Unknown block format {}", static_cast<std::uint32_t>(format)));
+}
+
+auto blocks_across(int const pixels) -> std::size_t
+{
+  return (static_cast<std::size_t>(pixels) + 3) / 4;
+}
+
+auto pixel_offset(int const width, int const x, int const y) -> std::size_t
+{
+  return (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)) * 4;
+}
+
+auto gather_block(RgbaView const& image, std::size_t const block_x, std::size_t const block_y, BlockPixels& block) -> void
+{
+  for(auto y = 0; y < 4; ++y) {
+    for(auto x = 0; x < 4; ++x) {
+      auto const source_x = std::min(static_cast<int>(block_x) * 4 + x, image.width - 1);
+      auto const source_y = std::min(static_cast<int>(block_y) * 4 + y, image.height - 1);
+      auto const* const pixel = image.pixels.data() + pixel_offset(image.width, source_x, source_y);
+
+      for(auto c = std::size_t(0); c < 4; ++c) {
+        block.channels[c][y * 4 + x] = static_cast<float>(std::to_integer<int>(pixel[c]));
+      }
+    }
+  }
+}
+
+using DecodedBlock = std::array<std::array<std::uint8_t, 4>, block_pixels_count>;
+
+auto load_u16(std::byte const* const bytes) -> unsigned
+{
+  return std::to_integer<unsigned>(bytes[0]) | (std::to_integer<unsigned>(bytes[1]) << 8U);
+}
+
+auto load_u64(std::byte const* const bytes, std::size_t const count) -> std::uint64_t
+{
+  auto value = std::uint64_t(0);
+  for(auto i = std::size_t(0); i < count; ++i) value |= std::to_integer<std::uint64_t>(bytes[i]) << (8 * i);
+
+  return value;
+}
+
+auto expand_565(unsigned const color) -> std::array<unsigned, 3>
+{
+  auto const r = (color >> 11U) & 31U;
+  auto const g = (color >> 5U) & 63U;
+  auto const b = color & 31U;
+
+  return { (r << 3U) | (r >> 2U), (g << 2U) | (g >> 4U), (b << 3U) | (b >> 2U) };
+}
+
+// `four_colors` for the color half of BC3, which ignores the endpoint order BC1 switches modes on.
+auto decode_color_block(std::byte const* const bytes, bool const four_colors, DecodedBlock& pixels) -> void
+{
+  auto const color0 = load_u16(bytes);
+  auto const color1 = load_u16(bytes + 2);
+  auto const first = expand_565(color0);
+  auto const last = expand_565(color1);
+
+  auto palette = std::array<std::array<std::uint8_t, 4>, 4>();
+
+  for(auto c = std::size_t(0); c < 3; ++c) {
+    palette[0][c] = static_cast<std::uint8_t>(first[c]);
+    palette[1][c] = static_cast<std::uint8_t>(last[c]);
+
+    if(four_colors or color0 > color1) {
+      palette[2][c] = static_cast<std::uint8_t>((2 * first[c] + last[c]) / 3);
+      palette[3][c] = static_cast<std::uint8_t>((first[c] + 2 * last[c]) / 3);
+    } else {
+      palette[2][c] = static_cast<std::uint8_t>((first[c] + last[c]) / 2);
+      palette[3][c] = 0;
+    }
+  }
+
+  for(auto& color : palette) color[3] = 255;
+
+  auto const indices = load_u64(bytes + 4, 4);
+
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) {
+    auto const alpha = pixels[i][3];
+    pixels[i] = palette[(indices >> (2 * i)) & 3U];
+    if(four_colors) pixels[i][3] = alpha;
+  }
+}
+
+auto decode_alpha_block(std::byte const* const bytes, DecodedBlock& pixels) -> void
+{
+  auto const alpha0 = std::to_integer<unsigned>(bytes[0]);
+  auto const alpha1 = std::to_integer<unsigned>(bytes[1]);
+
+  auto palette = std::array<unsigned, 8> { alpha0, alpha1 };
+
+  if(alpha0 > alpha1) {
+    for(auto i = 2U; i < 8; ++i) palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+  } else {
+    for(auto i = 2U; i < 6; ++i) palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  auto const indices = load_u64(bytes + 2, 6);
+
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) {
+    pixels[i][3] = static_cast<std::uint8_t>(palette[(indices >> (3 * i)) & 7U]);
+  }
+}
+
+// Reads a 128 bit block from its lowest bit up.
+class BlockBitReader
+{
+public:
+  explicit BlockBitReader(std::byte const* const bytes)
+    : words { load_u64(bytes, 8), load_u64(bytes + 8, 8) }
+  {}
+
+  auto take(unsigned const bits) -> unsigned
+  {
+    auto value = 0U;
+
+    for(auto bit = 0U; bit < bits; ++bit, ++position) {
+      value |= static_cast<unsigned>((words[position / 64] >> (position % 64)) & 1U) << bit;
+    }
+
+    return value;
+  }
+
+private:
+  std::array<std::uint64_t, 2> words;
+  unsigned position = 0;
+};
+
+auto decode_bc7_block(std::byte const* const bytes, DecodedBlock& pixels) -> void
+{
+  auto constexpr weights = std::array { 0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U };
+
+  auto bits = BlockBitReader(bytes);
+
+  if(bits.take(7) != 1U << 6U) {
+    pixels.fill({ 255, 0, 255, 255 });
+    return;
+  }
+
+  auto first = std::array<unsigned, 4>();
+  auto last = std::array<unsigned, 4>();
+
+  for(auto c = std::size_t(0); c < 4; ++c) {
+    first[c] = bits.take(7);
+    last[c] = bits.take(7);
+  }
+
+  auto const first_p_bit = bits.take(1);
+  auto const last_p_bit = bits.take(1);
+
+  for(auto c = std::size_t(0); c < 4; ++c) {
+    first[c] = (first[c] << 1U) | first_p_bit;
+    last[c] = (last[c] << 1U) | last_p_bit;
+  }
+
+  for(auto i = std::size_t(0); i < block_pixels_count; ++i) {
+    auto const weight = weights[bits.take(i == 0 ? 3 : 4)];
+
+    for(auto c = std::size_t(0); c < 4; ++c) {
+      pixels[i][c] = static_cast<std::uint8_t>(((64 - weight) * first[c] + weight * last[c] + 32) >> 6U);
+    }
+  }
+}
+
+} // namespace
+
+auto block_format_name(BlockFormat const format) -> char const*
+{
+  switch(format) {
+    case BlockFormat::Bc1: return "bc1";
+    case BlockFormat::Bc3: return "bc3";
+    case BlockFormat::Bc7: return "bc7";
+  }
+
+  return "unknown";
+}
+
+auto parse_block_format(std::string_view const name) -> tl::optional<BlockFormat>
+{
+  for(auto const format : { BlockFormat::Bc1, BlockFormat::Bc3, BlockFormat::Bc7 }) {
+    if(name == block_format_name(format)) return format;
+  }
+
+  return tl::nullopt;
+}
+
+auto block_size(BlockFormat const format) -> std::size_t
+{
+  return format == BlockFormat::Bc1 ? 8 : 16;
+}
+
+auto compressed_size(BlockFormat const format, int const width, int const height) -> std::size_t
+{
+  return blocks_across(width) * blocks_across(height) * block_size(format);
+}
+
+auto encode_blocks(JobSystem& jobs, RgbaView const image, BlockFormat const format, SimdLevel const level) -> std::vector<std::byte>
+{
+  if(image.width <= 0 or image.height <= 0 or image.pixels.size() != pixel_offset(image.width, 0, image.height)) {
+    throw std::invalid_argument(fmt::format("Got {} bytes for a {}x{} RGBA image", image.pixels.size(), image.width, image.height));
+  }
+
+  auto const encode = kernel_for(format, level);
+
+  auto const blocks_x = blocks_across(image.width);
+  auto const row_size = blocks_x * block_size(format);
+
+  auto blocks = std::vector<std::byte>(compressed_size(format, image.width, image.height));
+
+  // Enough blocks per job that the small mips of a chain don't spend more time scheduling than encoding.
+  auto constexpr min_blocks_per_job = std::size_t(256);
+  auto const rows_per_job = std::max(min_blocks_per_job / blocks_x, std::size_t(1));
+
+  auto counter = JobCounter();
+
+  jobs.parallel_for(
+    0,
+    blocks_across(image.height),
+    rows_per_job,
+    [&](std::size_t const first_row, std::size_t const end_row) {
+      auto row = std::vector<BlockPixels>(blocks_x);
+
+      for(auto block_y = first_row; block_y < end_row; ++block_y) {
+        for(auto block_x = std::size_t(0); block_x < blocks_x; ++block_x) gather_block(image, block_x, block_y, row[block_x]);
+
+        encode(row.data(), blocks_x, reinterpret_cast<std::uint8_t*>(blocks.data() + block_y * row_size)); // NOLINT
+      }
+    },
+    counter
+  );
+
+  jobs.wait(counter);
+
+  return blocks;
+}
+
+auto decode_blocks(std::span<std::byte const> const blocks, int const width, int const height, BlockFormat const format) -> std::vector<std::byte>
+{
+  if(width <= 0 or height <= 0 or blocks.size() != compressed_size(format, width, height)) {
+    throw std::invalid_argument(fmt::format("Got {} bytes of blocks for a {}x{} {} image", blocks.size(), width, height, block_format_name(format)));
+  }
+
+  auto pixels = std::vector<std::byte>(pixel_offset(width, 0, height));
+  auto const* block_bytes = blocks.data();
+
+  for(auto block_y = 0; block_y < height; block_y += 4) {
+    for(auto block_x = 0; block_x < width; block_x += 4, block_bytes += block_size(format)) {
+      auto decoded = DecodedBlock();
+
+      switch(format) {
+        case BlockFormat::Bc1: decode_color_block(block_bytes, false, decoded); break;
+
+        case BlockFormat::Bc3:
+          decode_alpha_block(block_bytes, decoded);
+          decode_color_block(block_bytes + 8, true, decoded);
+          break;
+
+        case BlockFormat::Bc7: decode_bc7_block(block_bytes, decoded); break;
+      }
+
+      for(auto y = 0; y < std::min(4, height - block_y); ++y) {
+        for(auto x = 0; x < std::min(4, width - block_x); ++x) {
+          auto const& pixel = decoded[static_cast<std::size_t>(y * 4 + x)];
+          auto* const destination = pixels.data() + pixel_offset(width, block_x + x, block_y + y);
+
+          for(auto c = std::size_t(0); c < 4; ++c) destination[c] = std::byte(pixel[c]);
+        }
+      }
+    }
+  }
+
+  return pixels;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+#include <tl/optional.hpp>
+
+#include "trujkont/simd/cpu_features.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+// GPU block compression formats, each stores 4x4 pixel blocks in a fixed number of bytes.
+// BC1 is opaque RGB at 4 bits per pixel, BC3 adds a separately encoded alpha, BC7 is RGBA at 8 bits per pixel with
+// the best quality of the three (`encode_blocks` only uses its single subset mode 6 though).
+enum class BlockFormat : std::uint32_t
+{
+  Bc1 = 1,
+  Bc3 = 3,
+  Bc7 = 7,
+};
+
+[[nodiscard]] auto block_format_name(BlockFormat format) -> char const*;
+
+[[nodiscard]] auto parse_block_format(std::string_view name) -> tl::optional<BlockFormat>;
+
+// Of one 4x4 block.
+[[nodiscard]] auto block_size(BlockFormat format) -> std::size_t;
+
+// Of a whole `width` x `height` image, partial blocks at the edges included.
+[[nodiscard]] auto compressed_size(BlockFormat format, int width, int height) -> std::size_t;
+
+// Tightly packed RGBA rows, 4 bytes per pixel.
+struct RgbaView
+{
+  std::span<std::byte const> pixels;
+  int width = 0;
+  int height = 0;
+};
+
+// Encodes rows of blocks in parallel on `jobs`. Partial blocks at the right and bottom edges repeat the last column and row.
+// Throws `std::invalid_argument` when `image.pixels` doesn't match its size.
+[[nodiscard]] auto encode_blocks(JobSystem& jobs, RgbaView image, BlockFormat format, SimdLevel level = best_simd_level()) -> std::vector<std::byte>;
+
+// Back to tightly packed RGBA rows, for drivers without support for the format and to measure the encoder's quality.
+// Only decodes BC7 mode 6, the one `encode_blocks` writes, blocks in any other mode come out magenta.
+[[nodiscard]] auto decode_blocks(std::span<std::byte const> blocks, int width, int height, BlockFormat format) -> std::vector<std::byte>;
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <numbers>
+#include <limits>
+#include <random>
+#include <vector>
+#include <array>
+#include <cmath>
+
+#include "trujkont/block_compression/block_compression_benchmark.hpp"
+#include "trujkont/block_compression/block_compression.hpp"
+#include "trujkont/benchmark/best_time.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr runs = 5;
+
+// Smooth gradients where the endpoints' precision shows, checkers where the palette's reach shows and noise on top,
+// with an alpha ramp so BC3 and BC7 have something to encode there too.
+auto synthetic_image(int const size) -> std::vector<std::byte>
+{
+  auto generator = std::mt19937(2137); // NOLINT
+  auto noise = std::uniform_int_distribution(-8, 8);
+
+  auto pixels = std::vector<std::byte>(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 4);
+  auto const frequency = 8 * std::numbers::pi_v<float> / static_cast<float>(size);
+
+  for(auto y = 0; y < size; ++y) {
+    for(auto x = 0; x < size; ++x) {
+      auto const checker = ((x / 24) + (y / 24)) % 2 == 0;
+
+      auto const channels = std::array {
+        static_cast<int>(127.5F + 127.5F * std::sin(static_cast<float>(x) * frequency)) + noise(generator),
+        static_cast<int>(127.5F + 127.5F * std::cos(static_cast<float>(y) * frequency)) + noise(generator),
+        (checker ? 200 : 40) + noise(generator),
+        x * 255 / std::max(size - 1, 1),
+      };
+
+      auto* const pixel = pixels.data() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(size) + static_cast<std::size_t>(x)) * 4;
+      for(auto c = std::size_t(0); c < 4; ++c) pixel[c] = std::byte(std::clamp(channels[c], 0, 255));
+    }
+  }
+
+  return pixels;
+}
+
+// BC1 has no alpha, so it's only measured on color.
+auto psnr(std::vector<std::byte> const& expected, std::vector<std::byte> const& actual, std::size_t const channels) -> double
+{
+  auto squared_error = 0.0;
+
+  for(auto i = std::size_t(0); i < expected.size(); i += 4) {
+    for(auto c = std::size_t(0); c < channels; ++c) {
+      auto const difference = std::to_integer<int>(expected[i + c]) - std::to_integer<int>(actual[i + c]);
+      squared_error += static_cast<double>(difference * difference);
+    }
+  }
+
+  auto const mean_squared_error = squared_error / static_cast<double>(expected.size() / 4 * channels);
+  if(mean_squared_error == 0.0) return std::numeric_limits<double>::infinity();
+
+  return 10.0 * std::log10(255.0 * 255.0 / mean_squared_error);
+}
+
+} // namespace
+
+auto benchmark_block_compression(std::size_t const size) -> std::string
+{
+  auto const side = static_cast<int>(std::min(size, std::size_t(8192)));
+  auto const pixels = synthetic_image(side);
+  auto const image = RgbaView { .pixels = pixels, .width = side, .height = side };
+  auto const megapixels = static_cast<double>(side) * static_cast<double>(side) / 1e6;
+
+  auto jobs = JobSystem();
+
+  auto report = fmt::format("{0}x{0} image, {1} workers, best of {2} runs\n", side, jobs.workers_count(), runs);
+
+  for(auto const format : { BlockFormat::Bc1, BlockFormat::Bc3, BlockFormat::Bc7 }) {
+    auto blocks = std::vector<std::byte>();
+
+    for(auto const level : { SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2 }) {
+      if(level > best_simd_level()) break;
+
+      auto const time = best_time(runs, [&] { blocks = encode_blocks(jobs, image, format, level); });
+      auto const decoded = decode_blocks(blocks, side, side, format);
+
+      report += fmt::format(
+        "{} {:>8}: {:8.3f} ms, {:7.2f} MP/s, PSNR {:5.2f} dB, {}x smaller\n",
+        block_format_name(format),
+        simd_level_name(level),
+        time,
+        megapixels / (time / 1000.0),
+        psnr(pixels, decoded, format == BlockFormat::Bc1 ? 3 : 4),
+        pixels.size() / blocks.size()
+      );
+    }
+  }
+
+  return report;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Encodes a synthetic `size` x `size` RGBA image (gradients, hard edges and noise) to every block format with every
+// compiled in kernel, on all the job system's workers, and reports the throughput and the PSNR of the decoded result.
+// Returns a human readable report.
+auto benchmark_block_compression(std::size_t size) -> std::string;
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+#include <array>
+
+#include "trujkont/block_compression/compressed_texture.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr file_magic = std::array { 'T', 'R', 'J', 'K', 'T', 'E', 'X', 'B' };
+auto constexpr file_version = std::uint32_t(1);
+
+// Blocks are read 16 bytes at a time, keeping each mip on such a boundary lets whatever maps the file hand them out as they are.
+auto constexpr mip_alignment = std::size_t(16);
+
+// Enough for a 2^31 sized texture, anything above is a corrupt header.
+auto constexpr max_mips_count = std::uint32_t(32);
+
+struct FileHeader
+{
+  std::array<char, 8> magic = file_magic;
+  std::uint32_t version = file_version;
+  std::uint32_t format = 0;
+  std::uint32_t width = 0;
+  std::uint32_t height = 0;
+  std::uint32_t mips_count = 0;
+  std::uint32_t reserved = 0;
+};
+
+static_assert(sizeof(FileHeader) == 32);
+
+struct MipEntry
+{
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+};
+
+static_assert(sizeof(MipEntry) == 16);
+
+auto mip_extent(int const extent, std::size_t const level) -> int
+{
+  return std::max(extent >> level, 1);
+}
+
+auto align_up(std::size_t const offset) -> std::size_t
+{
+  return (offset + mip_alignment - 1) / mip_alignment * mip_alignment;
+}
+
+} // namespace
+
+auto serialize_compressed_texture(BlockFormat const format, int const width, int const height, std::span<std::vector<std::byte> const> const mips)
+  -> std::vector<std::byte>
+{
+  if(mips.empty() or mips.size() > max_mips_count) {
+    throw std::invalid_argument(fmt::format("A texture needs between 1 and {} mips, got {}", max_mips_count, mips.size()));
+  }
+
+  auto const header = FileHeader {
+    .format = static_cast<std::uint32_t>(format),
+    .width = static_cast<std::uint32_t>(width),
+    .height = static_cast<std::uint32_t>(height),
+    .mips_count = static_cast<std::uint32_t>(mips.size()),
+  };
+
+  auto entries = std::vector<MipEntry>(mips.size());
+  auto end = align_up(sizeof(FileHeader) + entries.size() * sizeof(MipEntry));
+
+  for(auto level = std::size_t(0); level < mips.size(); ++level) {
+    auto const expected_size = compressed_size(format, mip_extent(width, level), mip_extent(height, level));
+
+    if(mips[level].size() != expected_size) {
+      throw std::invalid_argument(fmt::format("Mip {} has {} bytes of blocks, expected {}", level, mips[level].size(), expected_size));
+    }
+
+    entries[level] = MipEntry { .offset = end, .size = expected_size };
+    end = align_up(end + expected_size);
+  }
+
+  auto bytes = std::vector<std::byte>(end);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  std::memcpy(bytes.data() + sizeof(header), entries.data(), entries.size() * sizeof(MipEntry));
+
+  for(auto level = std::size_t(0); level < mips.size(); ++level) {
+    std::ranges::copy(mips[level], bytes.begin() + static_cast<std::ptrdiff_t>(entries[level].offset));
+  }
+
+  return bytes;
+}
+
+auto parse_compressed_texture(std::span<std::byte const> const bytes) -> tl::expected<CompressedTextureView, std::string>
+{
+  auto header = FileHeader();
+  if(bytes.size() < sizeof(header)) return tl::make_unexpected("Too short for a compressed texture header");
+
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if(header.magic != file_magic) return tl::make_unexpected("Not a compressed texture");
+
+  if(header.version != file_version) {
+    return tl::make_unexpected(fmt::format("Compressed texture version {}, expected {}", header.version, file_version));
+  }
+
+  auto const format = static_cast<BlockFormat>(header.format);
+
+  if(format != BlockFormat::Bc1 and format != BlockFormat::Bc3 and format != BlockFormat::Bc7) {
+    return tl::make_unexpected(fmt::format("Unknown block format {}", header.format));
+  }
+
+  auto constexpr max_extent = std::uint32_t(1) << 30U;
+
+  if(header.width == 0 or header.height == 0 or header.width > max_extent or header.height > max_extent) {
+    return tl::make_unexpected(fmt::format("Invalid compressed texture size {}x{}", header.width, header.height));
+  }
+
+  if(header.mips_count == 0 or header.mips_count > max_mips_count) {
+    return tl::make_unexpected(fmt::format("Invalid compressed texture mips count {}", header.mips_count));
+  }
+
+  auto const entries_end = sizeof(header) + header.mips_count * sizeof(MipEntry);
+  if(bytes.size() < entries_end) return tl::make_unexpected("Too short for its mips table");
+
+  auto view = CompressedTextureView {
+    .format = format,
+    .width = static_cast<int>(header.width),
+    .height = static_cast<int>(header.height),
+    .mips = {},
+  };
+
+  view.mips.reserve(header.mips_count);
+
+  for(auto level = std::size_t(0); level < header.mips_count; ++level) {
+    auto entry = MipEntry();
+    std::memcpy(&entry, bytes.data() + sizeof(header) + level * sizeof(MipEntry), sizeof(entry));
+
+    auto const width = mip_extent(view.width, level);
+    auto const height = mip_extent(view.height, level);
+
+    if(entry.size != compressed_size(format, width, height)) {
+      return tl::make_unexpected(fmt::format("Mip {} has {} bytes of blocks, expected {}", level, entry.size, compressed_size(format, width, height)));
+    }
+
+    if(entry.offset < entries_end or entry.offset > bytes.size() or entry.size > bytes.size() - entry.offset) {
+      return tl::make_unexpected(fmt::format("Mip {} at [{}, {}) is out of the file's {} bytes", level, entry.offset, entry.offset + entry.size, bytes.size()));
+    }
+
+    view.mips.push_back(CompressedMip {
+      .width = width,
+      .height = height,
+      .blocks = bytes.subspan(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.size)),
+    });
+  }
+
+  return view;
+}
+
+auto read_compressed_texture(std::filesystem::path const& path) -> tl::expected<CompressedTextureFile, std::string>
+{
+  auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+  if(not file) return tl::make_unexpected(fmt::format("Cannot find compressed texture @ \"{}\"", path.c_str()));
+
+  auto result = CompressedTextureFile();
+  result.bytes.resize(static_cast<std::size_t>(file.tellg()));
+
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(result.bytes.data()), static_cast<std::streamsize>(result.bytes.size())); // NOLINT
+
+  if(not file) return tl::make_unexpected(fmt::format("Cannot read compressed texture @ \"{}\"", path.c_str()));
+
+  auto view = parse_compressed_texture(result.bytes);
+  if(not view) return tl::make_unexpected(fmt::format("\"{}\": {}", path.c_str(), view.error()));
+
+  result.view = std::move(*view);
+
+  return result;
+}
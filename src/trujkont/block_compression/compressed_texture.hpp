@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <span>
+
+#include <tl/expected.hpp>
+
+#include "trujkont/block_compression/block_compression.hpp"
+
+// Baked textures: a block compressed mip chain in one file, parsed in place and handed to GL as is.
+//
+// Layout, little endian: a 32 byte header, one { offset, size } pair of 64 bit integers per mip, then the mips' blocks,
+// largest first, each starting at a multiple of 16 bytes from the start of the file.
+
+auto inline constexpr compressed_texture_extension = std::string_view(".tbc");
+
+struct CompressedMip
+{
+  int width = 0;
+  int height = 0;
+  std::span<std::byte const> blocks;
+};
+
+// Points into the bytes it was parsed from.
+struct CompressedTextureView
+{
+  BlockFormat format = BlockFormat::Bc1;
+  int width = 0;
+  int height = 0;
+
+  std::vector<CompressedMip> mips;
+};
+
+// A container read into memory. `view` points into `bytes`, which moving keeps valid, copying doesn't.
+struct CompressedTextureFile
+{
+  CompressedTextureFile() = default;
+
+  CompressedTextureFile(CompressedTextureFile const&) = delete;
+  CompressedTextureFile(CompressedTextureFile&&) = default;
+  auto operator=(CompressedTextureFile const&) -> CompressedTextureFile& = delete;
+  auto operator=(CompressedTextureFile&&) -> CompressedTextureFile& = default;
+
+  ~CompressedTextureFile() = default;
+
+  std::vector<std::byte> bytes;
+  CompressedTextureView view;
+};
+
+// `mips` are `encode_blocks` outputs, from `width` x `height` down, each half the size of the previous one (rounded down, at least 1).
+[[nodiscard]] auto serialize_compressed_texture(BlockFormat format, int width, int height, std::span<std::vector<std::byte> const> mips)
+  -> std::vector<std::byte>;
+
+// Checks everything a driver would otherwise read out of bounds on: the header, every mip's size and that it's within `bytes`.
+[[nodiscard]] auto parse_compressed_texture(std::span<std::byte const> bytes) -> tl::expected<CompressedTextureView, std::string>;
+
+[[nodiscard]] auto read_compressed_texture(std::filesystem::path const& path) -> tl::expected<CompressedTextureFile, std::string>;
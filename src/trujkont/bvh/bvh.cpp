@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+
+#include "trujkont/bvh/bvh.hpp"
+
+#include <fmt/format.h>
+
+auto Bvh::build(std::span<Aabb const> const bounds) -> void
+{
+  object_bounds.assign(bounds.begin(), bounds.end());
+
+  objects.resize(bounds.size());
+  std::iota(objects.begin(), objects.end(), std::uint32_t(0));
+
+  centers.resize(bounds.size());
+  std::ranges::transform(bounds, centers.begin(), &Aabb::center);
+
+  nodes.clear();
+  if(bounds.empty()) return;
+
+  nodes.reserve(2 * bounds.size());
+  nodes.push_back(Node { .bounds = Aabb(), .first = 0, .count = static_cast<std::uint32_t>(bounds.size()) });
+
+  subdivide(0, 0);
+}
+
+auto Bvh::refit(std::span<Aabb const> const bounds) -> void
+{
+  if(bounds.size() != object_bounds.size()) {
+    throw std::invalid_argument(fmt::format("Refitting {} objects, but the tree was built over {}", bounds.size(), object_bounds.size()));
+  }
+
+  object_bounds.assign(bounds.begin(), bounds.end());
+
+  // Children always come after their parents, so going backwards visits them first.
+  for(auto& node : nodes | std::views::reverse) {
+    node.bounds = Aabb();
+
+    if(node.is_leaf()) {
+      for(auto const object : std::span(objects).subspan(node.first, node.count)) node.bounds.grow(object_bounds[object]);
+    } else {
+      node.bounds.grow(nodes[node.left].bounds);
+      node.bounds.grow(nodes[node.left + 1].bounds);
+    }
+  }
+}
+
+auto Bvh::query(Frustum const& frustum, std::span<std::uint32_t> const visible) const -> std::size_t
+{
+  if(visible.size() < objects.size()) {
+    throw std::out_of_range(fmt::format("Room for {} visible objects, but there are {}", visible.size(), objects.size()));
+  }
+
+  if(nodes.empty()) return 0;
+
+  auto visible_count = std::size_t(0);
+
+  auto const take = [&](Node const& node) {
+    std::ranges::copy(std::span(objects).subspan(node.first, node.count), visible.begin() + static_cast<std::ptrdiff_t>(visible_count));
+    visible_count += node.count;
+  };
+
+  auto stack = std::array<std::uint32_t, max_depth + 2>();
+  auto stack_size = std::size_t(0);
+  stack[stack_size++] = 0;
+
+  while(stack_size > 0) {
+    auto const& node = nodes[stack[--stack_size]];
+
+    switch(frustum.classify_box(node.bounds.min, node.bounds.max)) {
+      case Containment::Outside: break;
+
+      case Containment::Inside: take(node); break;
+
+      case Containment::Intersecting:
+        if(not node.is_leaf()) {
+          stack[stack_size++] = node.left;
+          stack[stack_size++] = node.left + 1;
+          break;
+        }
+
+        for(auto const object : std::span(objects).subspan(node.first, node.count)) {
+          auto const& box = object_bounds[object];
+          if(frustum.classify_box(box.min, box.max) != Containment::Outside) visible[visible_count++] = object;
+        }
+        break;
+    }
+  }
+
+  return visible_count;
+}
+
+auto Bvh::objects_count() const noexcept -> std::size_t
+{
+  return objects.size();
+}
+
+auto Bvh::nodes_count() const noexcept -> std::size_t
+{
+  return nodes.size();
+}
+
+auto Bvh::subdivide(std::uint32_t const node_index, std::size_t const depth) -> void
+{
+  auto const node_objects = std::span(objects).subspan(nodes[node_index].first, nodes[node_index].count);
+
+  auto bounds = Aabb();
+  auto center_bounds = Aabb();
+  for(auto const object : node_objects) {
+    bounds.grow(object_bounds[object]);
+    center_bounds.grow(centers[object]);
+  }
+
+  nodes[node_index].bounds = bounds;
+
+  if(node_objects.size() <= max_leaf_objects or depth >= max_depth) return;
+
+  struct Bin
+  {
+    Aabb bounds;
+    std::uint32_t count = 0;
+  };
+
+  // Cost of a split relative to intersecting every object of the node, in units of one object test.
+  auto constexpr traversal_cost = 1.0F;
+
+  auto best_cost = static_cast<float>(node_objects.size());
+  auto best_axis = -1;
+  auto best_split = std::size_t(0);
+
+  for(auto axis = 0; axis < 3; ++axis) {
+    auto const extent = center_bounds.max[axis] - center_bounds.min[axis];
+    if(extent <= 0.0F) continue;
+
+    auto const bin_scale = static_cast<float>(bins_count) / extent;
+
+    auto bins = std::array<Bin, bins_count>();
+    for(auto const object : node_objects) {
+      auto const bin = std::min(bins_count - 1, static_cast<std::size_t>((centers[object][axis] - center_bounds.min[axis]) * bin_scale));
+
+      bins[bin].bounds.grow(object_bounds[object]);
+      ++bins[bin].count;
+    }
+
+    // Sweep from the right first, then evaluate every split plane between bins while sweeping from the left.
+    auto right_areas = std::array<float, bins_count>();
+    auto right_counts = std::array<std::uint32_t, bins_count>();
+    auto right = Bin();
+
+    for(auto split = bins_count - 1; split > 0; --split) {
+      right.bounds.grow(bins[split].bounds);
+      right.count += bins[split].count;
+
+      right_areas[split] = right.bounds.surface_area();
+      right_counts[split] = right.count;
+    }
+
+    auto left = Bin();
+    for(auto split = std::size_t(1); split < bins_count; ++split) {
+      left.bounds.grow(bins[split - 1].bounds);
+      left.count += bins[split - 1].count;
+
+      if(left.count == 0 or right_counts[split] == 0) continue;
+
+      auto const cost = traversal_cost
+                        + (left.bounds.surface_area() * static_cast<float>(left.count)
+                           + right_areas[split] * static_cast<float>(right_counts[split]))
+                            / bounds.surface_area();
+
+      if(cost < best_cost) {
+        best_cost = cost;
+        best_axis = axis;
+        best_split = split;
+      }
+    }
+  }
+
+  if(best_axis == -1) return;
+
+  auto const extent = center_bounds.max[best_axis] - center_bounds.min[best_axis];
+  auto const bin_scale = static_cast<float>(bins_count) / extent;
+
+  auto const right_begin = std::partition(node_objects.begin(), node_objects.end(), [&](std::uint32_t const object) {
+    auto const bin = std::min(bins_count - 1, static_cast<std::size_t>((centers[object][best_axis] - center_bounds.min[best_axis]) * bin_scale));
+    return bin < best_split;
+  });
+
+  auto const left_count = static_cast<std::uint32_t>(right_begin - node_objects.begin());
+  if(left_count == 0 or left_count == node_objects.size()) return;
+
+  auto const left_index = static_cast<std::uint32_t>(nodes.size());
+  auto const first = nodes[node_index].first;
+  auto const count = nodes[node_index].count;
+
+  nodes.push_back(Node { .bounds = Aabb(), .first = first, .count = left_count });
+  nodes.push_back(Node { .bounds = Aabb(), .first = first + left_count, .count = count - left_count });
+  nodes[node_index].left = left_index;
+
+  subdivide(left_index, depth + 1);
+  subdivide(left_index + 1, depth + 1);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <array>
+#include <span>
+
+#include "trujkont/geometry/geometry.hpp"
+#include "trujkont/culling/frustum.hpp"
+
+#include <tl/optional.hpp>
+
+struct RayHit
+{
+  std::uint32_t object = 0;
+  float distance = 0.0F;
+};
+
+// Bounding volume hierarchy over the boxes of many objects, object `i` being `bounds[i]` of the last build or refit.
+// Built top-down with a binned surface area heuristic; objects that only move a little are handled by `refit`,
+// which keeps the tree's shape and just recomputes its boxes, and a rebuild is only needed once that has degraded it.
+class Bvh
+{
+public:
+  auto build(std::span<Aabb const> bounds) -> void;
+
+  // `bounds` has to describe the same objects the tree was built over.
+  auto refit(std::span<Aabb const> bounds) -> void;
+
+  // Writes the objects whose box touches `frustum` to the front of `visible` and returns how many there are.
+  // Subtrees fully inside are taken whole without testing anything below them.
+  // `visible` has to have room for every object.
+  auto query(Frustum const& frustum, std::span<std::uint32_t> visible) const -> std::size_t;
+
+  // The closest object whose box the ray hits.
+  [[nodiscard]] auto raycast(Ray const& ray, float max_distance = std::numeric_limits<float>::max()) const -> tl::optional<RayHit>
+  {
+    return raycast(ray, max_distance, [](std::uint32_t, float const box_distance) -> tl::optional<float> { return box_distance; });
+  }
+
+  // Same, but objects whose box got hit are confirmed by `confirm(object, box_distance) -> tl::optional<float>`,
+  // which returns the exact distance to the object, or nothing if the ray misses the object inside its box.
+  template<typename Confirm>
+  [[nodiscard]] auto raycast(Ray const& ray, float const max_distance, Confirm&& confirm) const -> tl::optional<RayHit>
+  {
+    if(nodes.empty()) return tl::nullopt;
+
+    auto const inverse_direction = glm::vec3(1.0F) / ray.direction;
+
+    auto closest = tl::optional<RayHit>();
+    auto closest_distance = max_distance;
+
+    auto stack = std::array<std::uint32_t, max_depth + 2>();
+    auto stack_size = std::size_t(0);
+
+    if(intersect(ray, inverse_direction, nodes.front().bounds, closest_distance)) stack[stack_size++] = 0;
+
+    while(stack_size > 0) {
+      auto const& node = nodes[stack[--stack_size]];
+
+      if(node.is_leaf()) {
+        for(auto const object : std::span(objects).subspan(node.first, node.count)) {
+          auto const box_distance = intersect(ray, inverse_direction, object_bounds[object], closest_distance);
+          if(not box_distance) continue;
+
+          auto const distance = confirm(object, *box_distance);
+          if(distance and *distance <= closest_distance) {
+            closest_distance = *distance;
+            closest = RayHit { .object = object, .distance = *distance };
+          }
+        }
+
+        continue;
+      }
+
+      // Visit the nearer child first, so the farther one is more likely to be pruned by then.
+      auto const left = intersect(ray, inverse_direction, nodes[node.left].bounds, closest_distance);
+      auto const right = intersect(ray, inverse_direction, nodes[node.left + 1].bounds, closest_distance);
+
+      if(left and right) {
+        auto const left_first = *left <= *right;
+        stack[stack_size++] = left_first ? node.left + 1 : node.left;
+        stack[stack_size++] = left_first ? node.left : node.left + 1;
+      } else if(left) {
+        stack[stack_size++] = node.left;
+      } else if(right) {
+        stack[stack_size++] = node.left + 1;
+      }
+    }
+
+    return closest;
+  }
+
+  [[nodiscard]] auto objects_count() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto nodes_count() const noexcept -> std::size_t;
+
+private:
+  // Children are stored next to each other, `left` and `left + 1`, always after their parent.
+  // Every node, not only leaves, covers the contiguous range [first, first + count) of `objects`.
+  struct Node
+  {
+    Aabb bounds;
+
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+
+    // 0 for leaves, the root can't be anyone's child.
+    std::uint32_t left = 0;
+
+    [[nodiscard]] auto is_leaf() const noexcept -> bool { return left == 0; }
+  };
+
+  auto subdivide(std::uint32_t node_index, std::size_t depth) -> void;
+
+  std::vector<Node> nodes;
+  std::vector<std::uint32_t> objects;
+
+  std::vector<Aabb> object_bounds;
+  std::vector<glm::vec3> centers;
+
+  auto inline static constexpr max_leaf_objects = std::uint32_t(4);
+  auto inline static constexpr bins_count = std::size_t(16);
+
+  // Deeper nodes are left as leaves, which bounds the traversal stacks.
+  auto inline static constexpr max_depth = std::size_t(64);
+};
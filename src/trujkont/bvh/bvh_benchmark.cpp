@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <vector>
+
+#include "trujkont/bvh/bvh_benchmark.hpp"
+#include "trujkont/culling/culling.hpp"
+#include "trujkont/bvh/bvh.hpp"
+#include "trujkont/instanced_cubes/instanced_cubes.hpp"
+#include "trujkont/benchmark/best_time.hpp"
+
+#include <fmt/format.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+
+auto constexpr runs = 10;
+
+auto constexpr rays_count = std::size_t(100);
+
+} // namespace
+
+auto benchmark_bvh(std::size_t const count) -> std::string
+{
+  auto generator = std::mt19937(2137); // NOLINT
+  auto coordinate = std::uniform_real_distribution(-100.0F, 100.0F);
+  auto scale = std::uniform_real_distribution(0.25F, 4.0F);
+
+  auto transforms = TransformStore();
+  transforms.reserve(count);
+
+  for(auto i = std::size_t(0); i < count; ++i) {
+    transforms.push(
+      glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)),
+      glm::vec3(0., 1., 0.),
+      0.0F,
+      glm::vec3(scale(generator), scale(generator), scale(generator))
+    );
+  }
+
+  auto bounds = std::vector<Aabb>(count);
+  sphere_bounds(transforms, InstancedCubes::bounding_radius, bounds);
+
+  auto bvh = Bvh();
+  auto const build_time = best_time(runs, [&] { bvh.build(bounds); });
+
+  // Nudge everything a bit, like objects moving between two frames.
+  auto nudge = std::uniform_real_distribution(-0.5F, 0.5F);
+  for(auto& box : bounds) {
+    auto const offset = glm::vec3(nudge(generator), nudge(generator), nudge(generator));
+    box.min += offset;
+    box.max += offset;
+  }
+
+  auto const refit_time = best_time(runs, [&] { bvh.refit(bounds); });
+
+  auto report = fmt::format(
+    "{} objects, {} nodes, best of {} runs\n   build: {:8.3f} ms\n   refit: {:8.3f} ms\n",
+    count,
+    bvh.nodes_count(),
+    runs,
+    build_time,
+    refit_time
+  );
+
+  // Query with the boxes the tree was built over, so its answers can be compared to testing every box.
+  bvh.build(bounds);
+
+  auto const view = glm::lookAt(glm::vec3(0.), glm::vec3(0., 0., -1.), glm::vec3(0., 1., 0.));
+  auto const projection = glm::perspective(glm::radians(45.0F), 16.0F / 9.0F, 0.1F, 100.0F);
+  auto const frustum = Frustum(projection * view);
+
+  auto visible = std::vector<std::uint32_t>(count);
+  auto visible_count = std::size_t(0);
+
+  auto const query_time = best_time(runs, [&] { visible_count = bvh.query(frustum, visible); });
+
+  auto expected = std::vector<std::uint32_t>();
+  auto const linear_time = best_time(runs, [&] {
+    expected.clear();
+    for(auto i = std::size_t(0); i < count; ++i) {
+      if(frustum.classify_box(bounds[i].min, bounds[i].max) != Containment::Outside) expected.push_back(static_cast<std::uint32_t>(i));
+    }
+  });
+
+  auto spheres_visible = std::vector<std::uint32_t>(count);
+  auto const simd_time = best_time(runs, [&] { cull_spheres(transforms, InstancedCubes::bounding_radius, frustum, spheres_visible); });
+
+  auto found = std::vector<std::uint32_t>(visible.begin(), visible.begin() + static_cast<std::ptrdiff_t>(visible_count));
+  std::ranges::sort(found);
+
+  report += fmt::format(
+    "   query: {:8.3f} ms, {} visible, {}\n  linear: {:8.3f} ms (boxes), {:8.3f} ms (SIMD spheres)\n",
+    query_time,
+    visible_count,
+    found == expected ? "matches" : "MISMATCH",
+    linear_time,
+    simd_time
+  );
+
+  auto rays = std::vector<Ray>();
+  rays.reserve(rays_count);
+
+  for(auto i = std::size_t(0); i < rays_count; ++i) {
+    auto const target = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+    auto const origin = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+
+    rays.push_back(Ray { .origin = origin, .direction = glm::normalize(target - origin) });
+  }
+
+  auto hits = std::vector<tl::optional<RayHit>>(rays_count);
+  auto const raycast_time = best_time(runs, [&] {
+    for(auto i = std::size_t(0); i < rays_count; ++i) hits[i] = bvh.raycast(rays[i]);
+  });
+
+  auto brute_hits = std::vector<tl::optional<RayHit>>(rays_count);
+  auto const brute_time = best_time(runs, [&] {
+    for(auto i = std::size_t(0); i < rays_count; ++i) {
+      auto const& ray = rays[i];
+      auto const inverse_direction = glm::vec3(1.0F) / ray.direction;
+
+      auto closest = tl::optional<RayHit>();
+      for(auto object = std::size_t(0); object < count; ++object) {
+        auto const distance = intersect(ray, inverse_direction, bounds[object], closest ? closest->distance : std::numeric_limits<float>::max());
+        if(distance) closest = RayHit { .object = static_cast<std::uint32_t>(object), .distance = *distance };
+      }
+
+      brute_hits[i] = closest;
+    }
+  });
+
+  // Boxes overlapping at the exact hit distance may legitimately report different objects, so compare distances.
+  auto const rays_match = std::ranges::equal(hits, brute_hits, [](auto const& a, auto const& b) {
+    return a.has_value() == b.has_value() and (not a or a->distance == b->distance);
+  });
+
+  report += fmt::format(
+    "{} rays: {:8.3f} ms, testing every box: {:8.3f} ms, {}\n",
+    rays_count,
+    raycast_time,
+    brute_time,
+    rays_match ? "matches" : "MISMATCH"
+  );
+
+  return report;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Builds and refits a tree over `count` random objects, then compares its frustum queries with the linear SIMD
+// culling, and its ray casts with testing every box, checking both give the same answers. Returns a human readable report.
+auto benchmark_bvh(std::size_t count) -> std::string;
@@ -11,12 +11,36 @@ bool process_user_input = false;
 auto last_x = 400.f;
 auto last_y = 300.f;
 
+// In normalized device coordinates.
+tl::optional<glm::vec2> pending_pick;
+
 void mouse_click_callback(GLFWwindow* window, int button, int action, [[maybe_unused]] int mods)
 {
   if(button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     process_user_input = true;
   }
+
+  if(button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
+    if(process_user_input) {
+      pending_pick = glm::vec2(0.f, 0.f);
+      return;
+    }
+
+    auto cursor_x = 0.0;
+    auto cursor_y = 0.0;
+    glfwGetCursorPos(window, &cursor_x, &cursor_y);
+
+    auto width = 0;
+    auto height = 0;
+    glfwGetWindowSize(window, &width, &height);
+    if(width == 0 or height == 0) return;
+
+    pending_pick = glm::vec2(
+      static_cast<float>(2.0 * cursor_x / width - 1.0),
+      static_cast<float>(1.0 - 2.0 * cursor_y / height)
+    );
+  }
 }
 
 void mouse_move_callback([[maybe_unused]] GLFWwindow* const window, double const pos_x, double const pos_y)
@@ -58,7 +82,7 @@ auto Camera::update(long long delta_time, float aspect_ratio) -> std::pair<glm::
 
   auto const frustrum = orthogonal
                           ? glm::ortho(0.0f, 800.0f, 0.0f, 600.0f, 0.1f, 100.0f)
-                          : glm::perspective(glm::radians(45.f), aspect_ratio, 0.1f, 100.0f);
+                          : glm::perspective(field_of_view, aspect_ratio, 0.1f, 100.0f);
 
   return {
     glm::lookAt(position, position + reverse_direction, up_vector),
@@ -95,3 +119,26 @@ auto Camera::process_input(long long delta_time) -> void
     process_user_input = false;
   }
 }
+
+auto Camera::take_pick_ray(glm::mat4 const& view, glm::mat4 const& projection) -> tl::optional<Ray>
+{
+  if(not pending_pick) return tl::nullopt;
+
+  auto const point = *pending_pick;
+  pending_pick = tl::nullopt;
+
+  // Unproject the clicked point on the near and the far plane, the ray goes from one to the other.
+  auto const inverse_view_projection = glm::inverse(projection * view);
+
+  auto near = inverse_view_projection * glm::vec4(point.x, point.y, -1.f, 1.f);
+  auto far = inverse_view_projection * glm::vec4(point.x, point.y, 1.f, 1.f);
+  near /= near.w;
+  far /= far.w;
+
+  auto const origin = glm::vec3(near);
+
+  return Ray {
+    .origin = origin,
+    .direction = glm::normalize(glm::vec3(far) - origin)
+  };
+}
@@ -5,6 +5,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <tl/optional.hpp>
+
+#include "trujkont/geometry/geometry.hpp"
+
 struct GLFWwindow;
 
 class Camera
@@ -16,8 +20,15 @@ public:
 
   auto process_input(long long delta_time) -> void;
 
+  // Consumes the last right click: the ray through the clicked point, or through the middle of the screen while
+  // looking around (the cursor is hidden then). `view` and `projection` are what `update` returned this frame.
+  [[nodiscard]] auto take_pick_ray(glm::mat4 const& view, glm::mat4 const& projection) -> tl::optional<Ray>;
+
   glm::vec3 position = glm::vec3(0.);
 
+  // Vertical, in radians.
+  float field_of_view = glm::radians(45.F);
+
 private:
   GLFWwindow* window;
 
@@ -0,0 +1,36 @@
+#include <stdexcept>
+
+#include "trujkont/camera/camera_buffer.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+CameraBuffer::CameraBuffer(StreamBuffer& stream)
+  : stream(stream)
+{
+  auto alignment = GLint(0);
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+  offset_alignment = static_cast<std::size_t>(alignment);
+}
+
+auto CameraBuffer::update(glm::mat4 const& view, glm::mat4 const& projection, glm::vec3 const position) -> void
+{
+  // The rows of the view matrix' rotation part are the camera axes in world space.
+  auto const uniforms = CameraUniforms {
+    .view = view,
+    .projection = projection,
+    .view_projection = projection * view,
+    .position = glm::vec4(position, 1.0F),
+    .right = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0F),
+    .up = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0F),
+  };
+
+  auto allocation = stream.allocate<CameraUniforms>(1, offset_alignment);
+  if(not allocation) {
+    throw std::runtime_error("No room left for the camera uniforms in this frame's streaming region!");
+  }
+
+  allocation->data.front() = uniforms;
+
+  gl_state::bind_buffer_range(GL_UNIFORM_BUFFER, binding, stream.id(), allocation->offset, allocation->size_bytes());
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+
+#include <glm/glm.hpp>
+
+// Mirrors the std140 `Camera` uniform block declared by the shaders:
+//
+//   layout (std140, binding = 0) uniform Camera
+//   {
+//     mat4 view;
+//     mat4 projection;
+//     mat4 view_projection;
+//     vec4 camera_position;
+//     vec4 camera_right;
+//     vec4 camera_up;
+//   };
+struct CameraUniforms
+{
+  glm::mat4 view;
+  glm::mat4 projection;
+  glm::mat4 view_projection;
+  glm::vec4 position;
+  glm::vec4 right;
+  glm::vec4 up;
+};
+
+static_assert(sizeof(CameraUniforms) == 4 * 4 * 4 * 3 + 4 * 4 * 3, "CameraUniforms must stay std140 compatible");
+
+// The one buffer range all programs read the camera from. It's written once per frame into the frame's streaming region
+// and bound at `binding`, so neither switching programs nor adding new ones costs any camera uploads.
+class CameraBuffer
+{
+public:
+  explicit CameraBuffer(StreamBuffer& stream);
+
+  auto update(glm::mat4 const& view, glm::mat4 const& projection, glm::vec3 position) -> void;
+
+  auto inline static constexpr binding = 0U;
+
+private:
+  StreamBuffer& stream;
+
+  std::size_t offset_alignment = 0;
+};
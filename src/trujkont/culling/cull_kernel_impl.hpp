@@ -0,0 +1,95 @@
+#pragma once
+
+#include "trujkont/culling/cull_kernels.hpp"
+#include "trujkont/simd/simd_float.hpp"
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+template<typename V>
+struct SplatPlanes
+{
+  explicit SplatPlanes(FrustumPlanes const& planes)
+  {
+    for(auto i = std::size_t(0); i < frustum_plane_count; ++i) {
+      normal_x[i] = V::set1(planes.normal_x[i]);
+      normal_y[i] = V::set1(planes.normal_y[i]);
+      normal_z[i] = V::set1(planes.normal_z[i]);
+      distance[i] = V::set1(planes.distance[i]);
+    }
+  }
+
+  typename V::Float normal_x[frustum_plane_count]; // NOLINT(*-avoid-c-arrays)
+  typename V::Float normal_y[frustum_plane_count]; // NOLINT(*-avoid-c-arrays)
+  typename V::Float normal_z[frustum_plane_count]; // NOLINT(*-avoid-c-arrays)
+  typename V::Float distance[frustum_plane_count]; // NOLINT(*-avoid-c-arrays)
+};
+
+// One bit per lane of transforms [first, first + V::width), set for the ones whose sphere is not fully behind any plane.
+template<typename V>
+auto visible_lanes(TransformArrays const& transforms, std::size_t const first, float const bounding_radius, SplatPlanes<V> const& planes) -> unsigned
+{
+  auto const x = V::load(transforms.position_x + first);
+  auto const y = V::load(transforms.position_y + first);
+  auto const z = V::load(transforms.position_z + first);
+
+  auto const scale = V::max(V::max(V::load(transforms.scale_x + first), V::load(transforms.scale_y + first)), V::load(transforms.scale_z + first));
+  auto const negative_radius = V::mul(scale, V::set1(-bounding_radius));
+
+  auto outside = V::set1(0.0F);
+
+  for(auto i = std::size_t(0); i < frustum_plane_count; ++i) {
+    auto const distance = V::fmadd(
+      planes.normal_x[i],
+      x,
+      V::fmadd(planes.normal_y[i], y, V::fmadd(planes.normal_z[i], z, planes.distance[i]))
+    );
+
+    outside = V::bit_or(outside, V::less(distance, negative_radius));
+  }
+
+  auto constexpr all_lanes = (1U << V::width) - 1U;
+
+  return ~static_cast<unsigned>(V::mask(outside)) & all_lanes;
+}
+
+// Appends `first + lane` for every set lane without branching on the mask: the index is always written,
+// but the count only advances for visible lanes, so culled ones get overwritten by the next write.
+template<typename V>
+auto append_visible(unsigned const lanes, std::size_t const first, std::uint32_t* const visible, std::size_t visible_count) -> std::size_t
+{
+  for(auto lane = std::size_t(0); lane < V::width; ++lane) {
+    visible[visible_count] = static_cast<std::uint32_t>(first + lane);
+    visible_count += (lanes >> lane) & 1U;
+  }
+
+  return visible_count;
+}
+
+template<typename V>
+auto cull_spheres(
+  TransformArrays const& transforms,
+  std::size_t const count,
+  float const bounding_radius,
+  FrustumPlanes const& planes,
+  std::uint32_t* const visible
+) -> std::size_t
+{
+  auto const wide_planes = SplatPlanes<V>(planes);
+  auto const narrow_planes = SplatPlanes<ScalarFloats>(planes);
+
+  auto visible_count = std::size_t(0);
+  auto i = std::size_t(0);
+
+  for(; i + V::width <= count; i += V::width) {
+    visible_count = append_visible<V>(visible_lanes<V>(transforms, i, bounding_radius, wide_planes), i, visible, visible_count);
+  }
+
+  for(; i < count; ++i) {
+    visible_count = append_visible<ScalarFloats>(visible_lanes<ScalarFloats>(transforms, i, bounding_radius, narrow_planes), i, visible, visible_count);
+  }
+
+  return visible_count;
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+#include "trujkont/culling/cull_kernel_impl.hpp"
+
+namespace cull_kernels
+{
+
+auto cull_spheres_scalar(
+  TransformArrays const& transforms,
+  std::size_t const count,
+  float const bounding_radius,
+  FrustumPlanes const& planes,
+  std::uint32_t* const visible
+) -> std::size_t
+{
+  return cull_spheres<ScalarFloats>(transforms, count, bounding_radius, planes, visible);
+}
+
+auto cull_spheres_sse(
+  TransformArrays const& transforms,
+  std::size_t const count,
+  float const bounding_radius,
+  FrustumPlanes const& planes,
+  std::uint32_t* const visible
+) -> std::size_t
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  return cull_spheres<SseFloats>(transforms, count, bounding_radius, planes, visible);
+#else
+  return cull_spheres<ScalarFloats>(transforms, count, bounding_radius, planes, visible);
+#endif
+}
+
+#if not defined(TRUJKONT_AVX2_KERNELS)
+
+auto cull_spheres_avx2(
+  TransformArrays const& transforms,
+  std::size_t const count,
+  float const bounding_radius,
+  FrustumPlanes const& planes,
+  std::uint32_t* const visible
+) -> std::size_t
+{
+  return cull_spheres_sse(transforms, count, bounding_radius, planes, visible);
+}
+
+#endif
+
+} // namespace cull_kernels
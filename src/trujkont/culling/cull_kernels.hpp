@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "trujkont/transform/transform_kernels.hpp"
+
+auto inline constexpr frustum_plane_count = std::size_t(6);
+
+// Frustum planes as `dot(normal, point) + distance`, positive inside, normals unit length.
+// Stored one array per component so the kernels can splat them straight into vectors, and kept free of standard
+// library types for the same reason `TransformArrays` is.
+struct FrustumPlanes
+{
+  float normal_x[frustum_plane_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float normal_y[frustum_plane_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float normal_z[frustum_plane_count] = {}; // NOLINT(*-avoid-c-arrays)
+  float distance[frustum_plane_count] = {}; // NOLINT(*-avoid-c-arrays)
+};
+
+// Each tests the bounding spheres of transforms [0, count) against `planes` and writes the indices of the ones that
+// are at least partially inside to `visible`, in ascending order, returning how many it wrote.
+// A sphere is centered at the transform's position, its radius is `bounding_radius` times the largest scale component.
+// `visible` needs room for `count` indices.
+namespace cull_kernels
+{
+
+auto cull_spheres_scalar(TransformArrays const& transforms, std::size_t count, float bounding_radius, FrustumPlanes const& planes, std::uint32_t* visible) -> std::size_t;
+
+auto cull_spheres_sse(TransformArrays const& transforms, std::size_t count, float bounding_radius, FrustumPlanes const& planes, std::uint32_t* visible) -> std::size_t;
+
+auto cull_spheres_avx2(TransformArrays const& transforms, std::size_t count, float bounding_radius, FrustumPlanes const& planes, std::uint32_t* visible) -> std::size_t;
+
+} // namespace cull_kernels
@@ -0,0 +1,18 @@
+#include "trujkont/simd/simd_float_avx2.hpp"
+#include "trujkont/culling/cull_kernel_impl.hpp"
+
+namespace cull_kernels
+{
+
+auto cull_spheres_avx2(
+  TransformArrays const& transforms,
+  std::size_t const count,
+  float const bounding_radius,
+  FrustumPlanes const& planes,
+  std::uint32_t* const visible
+) -> std::size_t
+{
+  return cull_spheres<Avx2Floats>(transforms, count, bounding_radius, planes, visible);
+}
+
+} // namespace cull_kernels
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "trujkont/culling/culling.hpp"
+
+#include <fmt/format.h>
+
+auto culling_mode_name(CullingMode const mode) -> char const*
+{
+  switch(mode) {
+    case CullingMode::Off: return "off";
+    case CullingMode::Cpu: return "cpu";
+    case CullingMode::Bvh: return "bvh";
+    case CullingMode::Gpu: return "gpu";
+  }
+
+  return "unknown";
+}
+
+auto cull_spheres(
+  TransformStore const& transforms,
+  float const bounding_radius,
+  Frustum const& frustum,
+  std::span<std::uint32_t> const visible,
+  SimdLevel const level
+) -> std::size_t
+{
+  if(visible.size() < transforms.size()) {
+    throw std::out_of_range(fmt::format("Room for {} visible indices, but there are {} transforms", visible.size(), transforms.size()));
+  }
+
+  auto const arrays = transforms.arrays();
+  auto const& planes = frustum.kernel_planes();
+
+  switch(level) {
+    case SimdLevel::Scalar: return cull_kernels::cull_spheres_scalar(arrays, transforms.size(), bounding_radius, planes, visible.data());
+    case SimdLevel::Sse: return cull_kernels::cull_spheres_sse(arrays, transforms.size(), bounding_radius, planes, visible.data());
+    case SimdLevel::Avx2: return cull_kernels::cull_spheres_avx2(arrays, transforms.size(), bounding_radius, planes, visible.data());
+  }
+
+  return 0;
+}
+
+auto sphere_bounds(TransformStore const& transforms, float const bounding_radius, std::span<Aabb> const boxes) -> void
+{
+  if(boxes.size() < transforms.size()) {
+    throw std::out_of_range(fmt::format("Room for {} boxes, but there are {} transforms", boxes.size(), transforms.size()));
+  }
+
+  for(auto i = std::size_t(0); i < transforms.size(); ++i) {
+    auto const center = glm::vec3(transforms.position_x[i], transforms.position_y[i], transforms.position_z[i]);
+    auto const radius = bounding_radius * std::max({ transforms.scale_x[i], transforms.scale_y[i], transforms.scale_z[i] });
+
+    boxes[i] = Aabb { .min = center - glm::vec3(radius), .max = center + glm::vec3(radius) };
+  }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+#include "trujkont/transform/transform_store.hpp"
+#include "trujkont/geometry/geometry.hpp"
+#include "trujkont/culling/frustum.hpp"
+#include "trujkont/simd/cpu_features.hpp"
+
+enum class CullingMode
+{
+  Off,
+  Cpu,
+  Bvh,
+  Gpu
+};
+
+[[nodiscard]] auto culling_mode_name(CullingMode mode) -> char const*;
+
+// Writes the indices of the transforms whose bounding sphere touches `frustum` to the front of `visible`, in ascending
+// order, and returns how many there are. Spheres are centered at the transform's position, with `bounding_radius`
+// (the mesh's own, unscaled) times the largest scale component as radius, which assumes positive scales.
+// `visible` has to have room for every transform.
+auto cull_spheres(
+  TransformStore const& transforms,
+  float bounding_radius,
+  Frustum const& frustum,
+  std::span<std::uint32_t> visible,
+  SimdLevel level = best_simd_level()
+) -> std::size_t;
+
+// Boxes around the same bounding spheres `cull_spheres` tests, which don't change when the transforms only rotate.
+// `boxes` has to have room for every transform.
+auto sphere_bounds(TransformStore const& transforms, float bounding_radius, std::span<Aabb> boxes) -> void;
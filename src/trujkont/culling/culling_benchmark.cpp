@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "trujkont/culling/culling_benchmark.hpp"
+#include "trujkont/culling/culling.hpp"
+#include "trujkont/instanced_cubes/instanced_cubes.hpp"
+#include "trujkont/benchmark/best_time.hpp"
+
+#include <fmt/format.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+
+auto constexpr runs = 10;
+
+} // namespace
+
+auto benchmark_culling(std::size_t const count) -> std::string
+{
+  auto generator = std::mt19937(2137); // NOLINT
+  auto coordinate = std::uniform_real_distribution(-100.0F, 100.0F);
+  auto angle = std::uniform_real_distribution(-2 * std::numbers::pi_v<float>, 2 * std::numbers::pi_v<float>);
+  auto scale = std::uniform_real_distribution(0.25F, 4.0F);
+
+  auto transforms = TransformStore();
+  transforms.reserve(count);
+
+  for(auto i = std::size_t(0); i < count; ++i) {
+    transforms.push(
+      glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)),
+      glm::vec3(0., 1., 0.),
+      angle(generator),
+      glm::vec3(scale(generator), scale(generator), scale(generator))
+    );
+  }
+
+  auto const view = glm::lookAt(glm::vec3(0.), glm::vec3(0., 0., -1.), glm::vec3(0., 1., 0.));
+  auto const projection = glm::perspective(glm::radians(45.0F), 16.0F / 9.0F, 0.1F, 100.0F);
+  auto const frustum = Frustum(projection * view);
+
+  auto expected = std::vector<std::uint32_t>();
+  for(auto i = std::size_t(0); i < count; ++i) {
+    auto const center = glm::vec3(transforms.position_x[i], transforms.position_y[i], transforms.position_z[i]);
+    auto const radius = InstancedCubes::bounding_radius * std::max({ transforms.scale_x[i], transforms.scale_y[i], transforms.scale_z[i] });
+
+    if(frustum.intersects_sphere(center, radius)) expected.push_back(static_cast<std::uint32_t>(i));
+  }
+
+  auto report = fmt::format(
+    "{} transforms, {} ({:.1f}%) visible, best of {} runs\n",
+    count,
+    expected.size(),
+    count == 0 ? 0.0 : 100.0 * static_cast<double>(expected.size()) / static_cast<double>(count),
+    runs
+  );
+
+  auto visible = std::vector<std::uint32_t>(count);
+  auto visible_count = std::size_t(0);
+
+  for(auto const level : { SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2 }) {
+    if(level > best_simd_level()) break;
+
+    auto const time = best_time(runs, [&] { visible_count = cull_spheres(transforms, InstancedCubes::bounding_radius, frustum, visible, level); });
+    auto const matches = std::equal(expected.begin(), expected.end(), visible.begin(), visible.begin() + static_cast<std::ptrdiff_t>(visible_count));
+
+    report += fmt::format("{:>8} cull: {:8.3f} ms, {}\n", simd_level_name(level), time, matches ? "matches" : "MISMATCH");
+  }
+
+  auto models = std::vector<glm::mat4>(count);
+
+  auto const all_time = best_time(runs, [&] { write_model_matrices(transforms, models); });
+
+  auto const culled_time = best_time(runs, [&] {
+    visible_count = cull_spheres(transforms, InstancedCubes::bounding_radius, frustum, visible);
+    write_model_matrices(transforms, std::span(visible).first(visible_count), std::span(models).first(visible_count));
+  });
+
+  report += fmt::format(
+    "all matrices: {:8.3f} ms, cull + visible matrices: {:8.3f} ms, {} instead of {} instances uploaded\n",
+    all_time,
+    culled_time,
+    visible_count,
+    count
+  );
+
+  return report;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Culls `count` random transforms scattered around a camera with every compiled in kernel, checks them against
+// `Frustum::intersects_sphere`, and compares building all model matrices to culling first and building only the
+// visible ones. Returns a human readable report.
+auto benchmark_culling(std::size_t count) -> std::string;
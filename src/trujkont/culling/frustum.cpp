@@ -0,0 +1,65 @@
+#include "trujkont/culling/frustum.hpp"
+
+Frustum::Frustum(glm::mat4 const& view_projection)
+{
+  // glm is column major, so row `i` of the matrix is the `i`th component of every column.
+  auto const row = [&view_projection](int const i) {
+    return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+  };
+
+  plane_equations = {
+    row(3) + row(0),
+    row(3) - row(0),
+    row(3) + row(1),
+    row(3) - row(1),
+    row(3) + row(2),
+    row(3) - row(2),
+  };
+
+  for(auto i = std::size_t(0); i < plane_equations.size(); ++i) {
+    auto& plane = plane_equations[i];
+    plane /= glm::length(glm::vec3(plane));
+
+    split_planes.normal_x[i] = plane.x;
+    split_planes.normal_y[i] = plane.y;
+    split_planes.normal_z[i] = plane.z;
+    split_planes.distance[i] = plane.w;
+  }
+}
+
+auto Frustum::intersects_sphere(glm::vec3 const center, float const radius) const noexcept -> bool
+{
+  for(auto const& plane : plane_equations) {
+    if(glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+  }
+
+  return true;
+}
+
+auto Frustum::classify_box(glm::vec3 const min, glm::vec3 const max) const noexcept -> Containment
+{
+  auto result = Containment::Inside;
+
+  for(auto const& plane : plane_equations) {
+    auto const normal = glm::vec3(plane);
+
+    // The corners furthest along and against the plane normal.
+    auto const positive = glm::vec3(normal.x >= 0 ? max.x : min.x, normal.y >= 0 ? max.y : min.y, normal.z >= 0 ? max.z : min.z);
+    auto const negative = glm::vec3(normal.x >= 0 ? min.x : max.x, normal.y >= 0 ? min.y : max.y, normal.z >= 0 ? min.z : max.z);
+
+    if(glm::dot(normal, positive) + plane.w < 0) return Containment::Outside;
+    if(glm::dot(normal, negative) + plane.w < 0) result = Containment::Intersecting;
+  }
+
+  return result;
+}
+
+auto Frustum::planes() const noexcept -> std::array<glm::vec4, frustum_plane_count> const&
+{
+  return plane_equations;
+}
+
+auto Frustum::kernel_planes() const noexcept -> FrustumPlanes const&
+{
+  return split_planes;
+}
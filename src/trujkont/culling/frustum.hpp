@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "trujkont/culling/cull_kernels.hpp"
+
+enum class Containment
+{
+  Outside,
+  Intersecting,
+  Inside
+};
+
+// The six clip planes of a view * projection matrix (Gribb & Hartmann), in world space when given the camera's
+// view_projection. Ordered left, right, bottom, top, near, far, each facing inwards and normalized so distances are
+// in world units.
+class Frustum
+{
+public:
+  explicit Frustum(glm::mat4 const& view_projection);
+
+  [[nodiscard]] auto intersects_sphere(glm::vec3 center, float radius) const noexcept -> bool;
+
+  // Conservative: boxes that straddle two planes just outside a corner count as intersecting.
+  [[nodiscard]] auto classify_box(glm::vec3 min, glm::vec3 max) const noexcept -> Containment;
+
+  [[nodiscard]] auto planes() const noexcept -> std::array<glm::vec4, frustum_plane_count> const&;
+
+  // The same planes laid out for the batch kernels.
+  [[nodiscard]] auto kernel_planes() const noexcept -> FrustumPlanes const&;
+
+private:
+  std::array<glm::vec4, frustum_plane_count> plane_equations {};
+  FrustumPlanes split_planes;
+};
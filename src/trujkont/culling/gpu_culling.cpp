@@ -0,0 +1,129 @@
+#include <stdexcept>
+#include <array>
+#include <bit>
+
+#include "trujkont/culling/gpu_culling.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+#include <fmt/format.h>
+
+#include <glm/glm.hpp>
+
+namespace
+{
+
+auto load_cull_program()
+{
+  auto const stages = std::array { program_cache::StageFile { ShaderType::Compute, "src/trujkont/shaders/cull.comp" } };
+
+  auto program = program_cache::load_async(stages);
+  if(not program) {
+    fmt::print(stderr, "{}", program.error());
+    throw std::runtime_error("Cannot load culling compute shader!");
+  }
+
+  return *std::move(program);
+}
+
+} // namespace
+
+GpuCuller::GpuCuller(GLuint const indices_per_instance)
+  : program(load_cull_program()),
+    indices_per_instance(indices_per_instance)
+{
+  auto alignment = GLint(0);
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  storage_alignment = std::max(static_cast<std::size_t>(alignment), alignof(glm::mat4));
+
+  glGenBuffers(1, &visible_instances);
+
+  glGenBuffers(1, &command);
+  gl_state::bind_buffer(GL_DRAW_INDIRECT_BUFFER, command);
+  glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+
+  allocation = gpu_memory::track(gpu_memory::Category::Buffer, sizeof(DrawElementsIndirectCommand), "culled instances");
+}
+
+GpuCuller::~GpuCuller()
+{
+  gl_state::forget_buffer(command);
+  gl_state::forget_buffer(visible_instances);
+
+  glDeleteBuffers(1, &command);
+  glDeleteBuffers(1, &visible_instances);
+
+  gpu_memory::release(allocation);
+}
+
+auto GpuCuller::supported() -> bool
+{
+  return GLAD_GL_ARB_compute_shader != 0 and GLAD_GL_ARB_shader_storage_buffer_object != 0 and GLAD_GL_ARB_draw_indirect != 0;
+}
+
+auto GpuCuller::ready() const noexcept -> bool
+{
+  return program->ready();
+}
+
+auto GpuCuller::cull(GLuint const source, GLintptr const offset, std::size_t const count, float const bounding_radius) -> void
+{
+  if(not ready()) return;
+
+  if(program->generation() != program_generation) {
+    program_generation = program->generation();
+
+    instances_count_uniform = program->current()->uniform<unsigned int>("instances_count");
+    bounding_radius_uniform = program->current()->uniform<float>("bounding_radius");
+  }
+
+  reserve(count);
+
+  // Only the instance count is accumulated by the shader, the rest of the command is rewritten along with it.
+  auto const reset_command = DrawElementsIndirectCommand { .index_count = indices_per_instance };
+  gl_state::bind_buffer(GL_DRAW_INDIRECT_BUFFER, command);
+  glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(reset_command), &reset_command);
+
+  auto const size = static_cast<GLsizeiptr>(count * sizeof(glm::mat4));
+  gl_state::bind_buffer_range(GL_SHADER_STORAGE_BUFFER, instances_binding, source, offset, size);
+  gl_state::bind_buffer_range(GL_SHADER_STORAGE_BUFFER, visible_instances_binding, visible_instances, 0, size);
+  gl_state::bind_buffer_range(GL_SHADER_STORAGE_BUFFER, command_binding, command, 0, sizeof(DrawElementsIndirectCommand));
+
+  instances_count_uniform.set(static_cast<unsigned int>(count));
+  bounding_radius_uniform.set(bounding_radius);
+
+  program->current()->use();
+  glDispatchCompute(static_cast<GLuint>((count + group_size - 1) / group_size), 1, 1);
+
+  // The results are consumed as instance attributes and as the draw command, and the command is overwritten next frame.
+  glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+auto GpuCuller::source_alignment() const noexcept -> std::size_t
+{
+  return storage_alignment;
+}
+
+auto GpuCuller::instance_buffer() const noexcept -> GLuint
+{
+  return visible_instances;
+}
+
+auto GpuCuller::command_buffer() const noexcept -> GLuint
+{
+  return command;
+}
+
+auto GpuCuller::reserve(std::size_t const count) -> void
+{
+  if(count <= visible_instances_capacity) return;
+
+  // Grown in powers of two so a slowly growing scene doesn't reallocate every frame.
+  // The storage is replaced in place, vertex arrays sourcing the buffer keep pointing at it.
+  visible_instances_capacity = std::bit_ceil(count);
+
+  gl_state::bind_buffer(GL_SHADER_STORAGE_BUFFER, visible_instances);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(visible_instances_capacity * sizeof(glm::mat4)), nullptr, GL_DYNAMIC_COPY);
+
+  gpu_memory::resize(allocation, visible_instances_capacity * sizeof(glm::mat4) + sizeof(DrawElementsIndirectCommand));
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include "trujkont/shader_program/program_cache.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+
+// Layout of `glDrawElementsIndirect` commands.
+struct DrawElementsIndirectCommand
+{
+  GLuint index_count = 0;
+  GLuint instance_count = 0;
+  GLuint first_index = 0;
+  GLint base_vertex = 0;
+  GLuint base_instance = 0;
+};
+
+// Frustum culls instances entirely on the GPU. A compute pass (shaders/cull.comp) reads every instance's model matrix,
+// tests its bounding sphere against the camera from the `Camera` uniform block, appends the survivors to its own
+// instance buffer and counts them into an indirect draw command, so the CPU never learns what's visible.
+//
+// Usage per frame: `cull()` once the camera buffer is bound, then draw `instance_buffer()` with `command_buffer()`.
+class GpuCuller
+{
+public:
+  explicit GpuCuller(GLuint indices_per_instance);
+
+  GpuCuller(GpuCuller const&) = delete;
+  GpuCuller(GpuCuller&&) = delete;
+  auto operator=(GpuCuller const&) -> GpuCuller& = delete;
+  auto operator=(GpuCuller&&) -> GpuCuller& = delete;
+
+  ~GpuCuller();
+
+  // Whether the context has everything the pass needs: compute shaders, storage buffers and indirect draws.
+  [[nodiscard]] auto static supported() -> bool;
+
+  // The compute program is compiled in the background, nothing can be culled until it's linked.
+  [[nodiscard]] auto ready() const noexcept -> bool;
+
+  // Culls the `count` tightly packed `glm::mat4` model matrices at `offset` in `source`,
+  // `offset` has to be a multiple of `source_alignment()`.
+  auto cull(GLuint source, GLintptr offset, std::size_t count, float bounding_radius) -> void;
+
+  [[nodiscard]] auto source_alignment() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto instance_buffer() const noexcept -> GLuint;
+
+  [[nodiscard]] auto command_buffer() const noexcept -> GLuint;
+
+  auto inline static constexpr instances_binding = 0U;
+  auto inline static constexpr visible_instances_binding = 1U;
+  auto inline static constexpr command_binding = 2U;
+
+private:
+  auto reserve(std::size_t count) -> void;
+
+  program_cache::AsyncProgramHandle program;
+  std::uint64_t program_generation = 0;
+
+  Uniform<unsigned int> instances_count_uniform;
+  Uniform<float> bounding_radius_uniform;
+
+  GLuint indices_per_instance;
+
+  GLuint visible_instances = 0;
+  std::size_t visible_instances_capacity = 0;
+
+  GLuint command = 0;
+
+  // Both buffers, resized along with the visible instances.
+  gpu_memory::AllocationId allocation = 0;
+
+  std::size_t storage_alignment = 0;
+
+  auto inline static constexpr group_size = std::size_t(64);
+};
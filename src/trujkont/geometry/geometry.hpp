@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include <tl/optional.hpp>
+
+// Axis aligned box, empty (inverted) until something is added to it.
+struct Aabb
+{
+  glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+  glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+  auto grow(glm::vec3 const point) -> void
+  {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+
+  auto grow(Aabb const& box) -> void
+  {
+    min = glm::min(min, box.min);
+    max = glm::max(max, box.max);
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return min.x > max.x or min.y > max.y or min.z > max.z;
+  }
+
+  [[nodiscard]] auto center() const -> glm::vec3
+  {
+    return (min + max) * 0.5F;
+  }
+
+  [[nodiscard]] auto surface_area() const -> float
+  {
+    if(empty()) return 0.0F;
+
+    auto const size = max - min;
+    return 2.0F * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+};
+
+struct Ray
+{
+  glm::vec3 origin = glm::vec3(0.);
+  glm::vec3 direction = glm::vec3(0., 0., -1.);
+};
+
+// Slab test. Returns the distance along the ray (in units of `direction`) to where it enters `box`, 0 when it starts
+// inside, or nothing when it misses or only gets there past `max_distance`.
+// `inverse_direction` is `1 / ray.direction`, hoisted out since it's shared by every box a ray is tested against.
+[[nodiscard]] auto inline intersect(Ray const& ray, glm::vec3 const inverse_direction, Aabb const& box, float const max_distance) -> tl::optional<float>
+{
+  auto const to_min = (box.min - ray.origin) * inverse_direction;
+  auto const to_max = (box.max - ray.origin) * inverse_direction;
+
+  auto const near = glm::min(to_min, to_max);
+  auto const far = glm::max(to_min, to_max);
+
+  auto const enter = std::max({ near.x, near.y, near.z, 0.0F });
+  auto const exit = std::min({ far.x, far.y, far.z, max_distance });
+
+  if(enter > exit) return tl::nullopt;
+
+  return enter;
+}
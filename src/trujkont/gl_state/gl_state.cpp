@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <atomic>
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr unknown = ~GLuint(0);
+
+auto constexpr buffer_targets = std::array<GLenum, 7> {
+  GL_ARRAY_BUFFER,
+  GL_ELEMENT_ARRAY_BUFFER,
+  GL_UNIFORM_BUFFER,
+  GL_SHADER_STORAGE_BUFFER,
+  GL_DRAW_INDIRECT_BUFFER,
+  GL_PIXEL_UNPACK_BUFFER,
+  GL_COPY_WRITE_BUFFER
+};
+
+auto constexpr texture_targets = std::array<GLenum, 2> {
+  GL_TEXTURE_2D,
+  GL_TEXTURE_2D_ARRAY
+};
+
+auto constexpr capabilities = std::array<GLenum, 4> {
+  GL_DEPTH_TEST,
+  GL_BLEND,
+  GL_CULL_FACE,
+  GL_SCISSOR_TEST
+};
+
+auto constexpr max_texture_units = 32U;
+
+struct State
+{
+  GLuint program = unknown;
+  GLuint vertex_array = unknown;
+
+  std::array<GLuint, buffer_targets.size()> buffers {};
+
+  GLuint active_unit = unknown;
+  std::array<std::array<GLuint, texture_targets.size()>, max_texture_units> textures {};
+
+  std::array<GLuint, capabilities.size()> enabled {};
+
+  GLenum blend_source = unknown;
+  GLenum blend_destination = unknown;
+
+  State()
+  {
+    buffers.fill(unknown);
+    enabled.fill(unknown);
+    for(auto& unit : textures) unit.fill(unknown);
+  }
+};
+
+auto state = State();
+
+struct AtomicCounter
+{
+  std::atomic<std::uint64_t> issued = 0;
+  std::atomic<std::uint64_t> elided = 0;
+};
+
+auto counters_storage = std::array<AtomicCounter, static_cast<std::size_t>(gl_state::StateKind::Count)>();
+
+// There's only ever one writer (the GL thread), so a plain load + store is enough and avoids a locked add on every bind.
+auto count(std::atomic<std::uint64_t>& counter)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Returns whether the call has to reach the driver.
+auto update(gl_state::StateKind const kind, GLuint& cached, GLuint const value)
+{
+  auto& counter = counters_storage[static_cast<std::size_t>(kind)];
+
+  if(cached == value) {
+    count(counter.elided);
+    return false;
+  }
+
+  cached = value;
+  count(counter.issued);
+
+  return true;
+}
+
+template<std::size_t Size>
+auto index_of(std::array<GLenum, Size> const& values, GLenum const value) -> std::size_t
+{
+  return static_cast<std::size_t>(std::ranges::find(values, value) - values.begin());
+}
+
+auto constexpr element_array_index = 1U;
+
+} // namespace
+
+namespace gl_state
+{
+
+auto use_program(GLuint const program) -> void
+{
+  if(update(StateKind::Program, state.program, program)) glUseProgram(program);
+}
+
+auto bind_vertex_array(GLuint const vertex_array) -> void
+{
+  if(not update(StateKind::VertexArray, state.vertex_array, vertex_array)) return;
+
+  glBindVertexArray(vertex_array);
+
+  // The element array binding is part of the vertex array object, not of the context.
+  state.buffers[element_array_index] = unknown;
+}
+
+auto bind_buffer(GLenum const target, GLuint const buffer) -> void
+{
+  auto const index = index_of(buffer_targets, target);
+
+  if(index == buffer_targets.size()) {
+    count(counters_storage[static_cast<std::size_t>(StateKind::Buffer)].issued);
+    glBindBuffer(target, buffer);
+    return;
+  }
+
+  if(update(StateKind::Buffer, state.buffers[index], buffer)) glBindBuffer(target, buffer);
+}
+
+auto bind_buffer_range(GLenum const target, GLuint const index, GLuint const buffer, GLintptr const offset, GLsizeiptr const size) -> void
+{
+  count(counters_storage[static_cast<std::size_t>(StateKind::Buffer)].issued);
+  glBindBufferRange(target, index, buffer, offset, size);
+
+  if(auto const target_index = index_of(buffer_targets, target); target_index != buffer_targets.size()) {
+    state.buffers[target_index] = buffer;
+  }
+}
+
+auto active_texture(GLuint const unit) -> void
+{
+  if(update(StateKind::TextureUnit, state.active_unit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+auto bind_texture(GLenum const target, GLuint const texture) -> void
+{
+  auto const index = index_of(texture_targets, target);
+
+  if(index == texture_targets.size() or state.active_unit >= max_texture_units) {
+    count(counters_storage[static_cast<std::size_t>(StateKind::Texture)].issued);
+    glBindTexture(target, texture);
+    return;
+  }
+
+  if(update(StateKind::Texture, state.textures[state.active_unit][index], texture)) glBindTexture(target, texture);
+}
+
+auto set_enabled(GLenum const capability, bool const enabled) -> void
+{
+  auto const index = index_of(capabilities, capability);
+
+  auto dummy = unknown;
+  auto& cached = index == capabilities.size() ? dummy : state.enabled[index];
+
+  if(not update(StateKind::Capability, cached, enabled ? GL_TRUE : GL_FALSE)) return;
+
+  if(enabled) {
+    glEnable(capability);
+  } else {
+    glDisable(capability);
+  }
+}
+
+auto blend_func(GLenum const source_factor, GLenum const destination_factor) -> void
+{
+  auto& counter = counters_storage[static_cast<std::size_t>(StateKind::BlendFunc)];
+
+  if(state.blend_source == source_factor and state.blend_destination == destination_factor) {
+    count(counter.elided);
+    return;
+  }
+
+  state.blend_source = source_factor;
+  state.blend_destination = destination_factor;
+  count(counter.issued);
+
+  glBlendFunc(source_factor, destination_factor);
+}
+
+auto forget_program(GLuint const program) -> void
+{
+  if(state.program == program) state.program = unknown;
+}
+
+auto forget_vertex_array(GLuint const vertex_array) -> void
+{
+  if(state.vertex_array == vertex_array) state.vertex_array = unknown;
+}
+
+auto forget_buffer(GLuint const buffer) -> void
+{
+  std::ranges::replace(state.buffers, buffer, unknown);
+}
+
+auto forget_texture(GLuint const texture) -> void
+{
+  for(auto& unit : state.textures) std::ranges::replace(unit, texture, unknown);
+}
+
+auto invalidate() -> void
+{
+  state = State();
+}
+
+auto counters() -> Counters
+{
+  auto result = Counters();
+
+  std::ranges::transform(counters_storage, result.begin(), [](AtomicCounter const& counter) {
+    return Counter { counter.issued.load(std::memory_order_relaxed), counter.elided.load(std::memory_order_relaxed) };
+  });
+
+  return result;
+}
+
+auto report() -> std::string
+{
+  auto constexpr names = std::array {
+    "program",
+    "vertex array",
+    "buffer",
+    "texture unit",
+    "texture",
+    "capability",
+    "blend func"
+  };
+
+  static_assert(names.size() == static_cast<std::size_t>(StateKind::Count));
+
+  auto const current = counters();
+  auto result = std::string();
+
+  for(auto i = 0U; i < current.size(); ++i) {
+    auto const [issued, elided] = current[i];
+    auto const total = issued + elided;
+
+    result += fmt::format(
+      "{:>14}: {:>10} issued, {:>10} elided ({:.1f}%)\n",
+      names[i],
+      issued,
+      elided,
+      total == 0 ? 0. : 100. * static_cast<double>(elided) / static_cast<double>(total)
+    );
+  }
+
+  return result;
+}
+
+} // namespace gl_state
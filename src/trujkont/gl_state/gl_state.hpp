@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <array>
+
+#include <glad/glad.h>
+
+// Shadow of the bits of GL context state the renderer touches every frame.
+// Every bind or enable goes through here and is only forwarded to the driver when it actually changes something;
+// the dropped ones are counted, so the remaining redundancy can be inspected at runtime.
+// Must only be used from the thread owning the GL context (the counters can be read from anywhere).
+namespace gl_state
+{
+
+enum class StateKind
+{
+  Program,
+  VertexArray,
+  Buffer,
+  TextureUnit,
+  Texture,
+  Capability,
+  BlendFunc,
+
+  Count
+};
+
+struct Counter
+{
+  std::uint64_t issued = 0;
+  std::uint64_t elided = 0;
+};
+
+using Counters = std::array<Counter, static_cast<std::size_t>(StateKind::Count)>;
+
+auto use_program(GLuint program) -> void;
+
+auto bind_vertex_array(GLuint vertex_array) -> void;
+
+auto bind_buffer(GLenum target, GLuint buffer) -> void;
+
+// Indexed binds (uniform, shader storage) also change the generic binding of `target`, which is kept in sync here.
+auto bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) -> void;
+
+auto active_texture(GLuint unit) -> void;
+
+// Binds to the currently active texture unit.
+auto bind_texture(GLenum target, GLuint texture) -> void;
+
+auto set_enabled(GLenum capability, bool enabled) -> void;
+
+auto blend_func(GLenum source_factor, GLenum destination_factor) -> void;
+
+// Must be called before deleting a GL object, GL may hand out its name again right after.
+auto forget_program(GLuint program) -> void;
+auto forget_vertex_array(GLuint vertex_array) -> void;
+auto forget_buffer(GLuint buffer) -> void;
+auto forget_texture(GLuint texture) -> void;
+
+// Drops everything that's cached, for when something outside of this module has changed the state.
+auto invalidate() -> void;
+
+[[nodiscard]] auto counters() -> Counters;
+
+[[nodiscard]] auto report() -> std::string;
+
+} // namespace gl_state
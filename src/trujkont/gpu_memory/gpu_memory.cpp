@@ -0,0 +1,236 @@
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <span>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+using namespace gpu_memory;
+
+struct Allocation
+{
+  Category category = Category::Texture;
+  std::size_t size = 0;
+  std::string label;
+  Evictor evictor;
+  std::uint64_t last_used = 0;
+};
+
+struct CategoryTotal
+{
+  std::size_t size = 0;
+  std::size_t count = 0;
+};
+
+// How many of the largest allocations `report` lists.
+auto constexpr largest_reported = std::size_t(5);
+
+auto constexpr bytes_per_mebibyte = 1024.0 * 1024.0;
+
+// Guards everything below, `report` reads it from the commandline's thread.
+auto mutex = std::mutex();
+
+auto allocations = std::unordered_map<AllocationId, Allocation>();
+auto totals = std::array<CategoryTotal, static_cast<std::size_t>(Category::Count)>();
+auto total = std::size_t(0);
+
+auto next_id = AllocationId(1);
+auto frame = std::uint64_t(0);
+
+auto current_budget = std::atomic<std::size_t>(default_budget);
+auto evictions = std::atomic<std::uint64_t>(0);
+
+auto total_of(Category const category) -> CategoryTotal&
+{
+  return totals[static_cast<std::size_t>(category)];
+}
+
+auto mebibytes(std::size_t const size) -> double
+{
+  return static_cast<double>(size) / bytes_per_mebibyte;
+}
+
+} // namespace
+
+namespace gpu_memory
+{
+
+auto category_name(Category const category) -> char const*
+{
+  switch(category) {
+    case Category::Texture: return "textures";
+    case Category::Mesh: return "meshes";
+    case Category::Buffer: return "buffers";
+    case Category::Count: break;
+  }
+
+  return "unknown";
+}
+
+auto track(Category const category, std::size_t const size, std::string label, Evictor evictor) -> AllocationId
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  auto const id = next_id++;
+
+  allocations.emplace(
+    id,
+    Allocation { .category = category, .size = size, .label = std::move(label), .evictor = std::move(evictor), .last_used = frame }
+  );
+
+  total_of(category).size += size;
+  total_of(category).count += 1;
+  total += size;
+
+  return id;
+}
+
+auto resize(AllocationId const allocation, std::size_t const size) -> void
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  auto const found = allocations.find(allocation);
+  if(found == allocations.end()) return;
+
+  auto& resized = found->second;
+
+  total_of(resized.category).size = total_of(resized.category).size - resized.size + size;
+  total = total - resized.size + size;
+  resized.size = size;
+}
+
+auto release(AllocationId const allocation) -> void
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  auto const found = allocations.find(allocation);
+  if(found == allocations.end()) return;
+
+  auto const& released = found->second;
+
+  total_of(released.category).size -= released.size;
+  total_of(released.category).count -= 1;
+  total -= released.size;
+
+  allocations.erase(found);
+}
+
+auto touch(AllocationId const allocation) -> void
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  auto const found = allocations.find(allocation);
+  if(found != allocations.end()) found->second.last_used = frame;
+}
+
+auto set_budget(std::size_t const budget) -> void
+{
+  current_budget.store(budget, std::memory_order_relaxed);
+}
+
+auto budget() -> std::size_t
+{
+  return current_budget.load(std::memory_order_relaxed);
+}
+
+auto fits(std::size_t const size) -> bool
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  return total + size <= budget();
+}
+
+auto enforce() -> std::size_t
+{
+  struct Candidate
+  {
+    std::uint64_t last_used = 0;
+    Evictor evictor;
+  };
+
+  auto candidates = std::vector<Candidate>();
+
+  {
+    auto const lock = std::scoped_lock(mutex);
+
+    ++frame;
+
+    if(total <= budget()) return 0;
+
+    for(auto const& [id, allocation] : allocations) {
+      if(allocation.evictor and allocation.last_used + 1 < frame) {
+        candidates.push_back(Candidate { .last_used = allocation.last_used, .evictor = allocation.evictor });
+      }
+    }
+  }
+
+  std::ranges::sort(candidates, {}, &Candidate::last_used);
+
+  auto evicted = std::size_t(0);
+
+  // Evictors release or resize their allocation, so they are called without holding the lock.
+  for(auto const& candidate : candidates) {
+    {
+      auto const lock = std::scoped_lock(mutex);
+      if(total <= budget()) break;
+    }
+
+    if(candidate.evictor()) ++evicted;
+  }
+
+  evictions.fetch_add(evicted, std::memory_order_relaxed);
+
+  return evicted;
+}
+
+auto report() -> std::string
+{
+  auto const lock = std::scoped_lock(mutex);
+
+  auto result = fmt::format(
+    "vram: {:.1f} of {:.1f} MiB{}, {} evicted\n",
+    mebibytes(total),
+    mebibytes(budget()),
+    total > budget() ? " (over budget)" : "",
+    evictions.load(std::memory_order_relaxed)
+  );
+
+  for(auto category = std::size_t(0); category < totals.size(); ++category) {
+    result += fmt::format(
+      "{:>10}: {:>8.1f} MiB in {} allocations\n",
+      category_name(static_cast<Category>(category)),
+      mebibytes(totals[category].size),
+      totals[category].count
+    );
+  }
+
+  auto largest = std::vector<Allocation const*>();
+  largest.reserve(allocations.size());
+
+  for(auto const& [id, allocation] : allocations) largest.push_back(&allocation);
+
+  auto const reported = std::min(largest.size(), largest_reported);
+  std::ranges::partial_sort(largest, largest.begin() + static_cast<std::ptrdiff_t>(reported), std::ranges::greater(), &Allocation::size);
+
+  for(auto const* const allocation : std::span(largest).first(reported)) {
+    result += fmt::format(
+      "{:>10.1f} MiB {}{}\n",
+      mebibytes(allocation->size),
+      allocation->label,
+      allocation->evictor ? "" : " (pinned)"
+    );
+  }
+
+  return result;
+}
+
+} // namespace gpu_memory
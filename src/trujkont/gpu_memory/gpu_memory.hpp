@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Bookkeeping of what the renderer keeps in GPU memory, per allocation and category, held against a budget.
+// GL never says how much an object really takes, sizes are what was asked for (levels, layers, buffer stores),
+// which is close enough to see where the memory goes and to keep the total bounded.
+//
+// Allocations that can be brought back on demand come with an `Evictor`. Once a frame `enforce` evicts the least
+// recently used of those until the total is back under the budget, the rest are only counted.
+// Like `gl_state`, must only be used from the thread owning the GL context, except for `set_budget` and `report`.
+namespace gpu_memory
+{
+
+enum class Category
+{
+  Texture,
+  Mesh,
+  Buffer,
+
+  Count
+};
+
+// 0 is never handed out, it stands for no allocation and is ignored by everything taking one.
+using AllocationId = std::uint64_t;
+
+// Gives the allocation's memory back, releasing or shrinking it, and returns true. Returns false when it can't
+// right now (e.g. it's still being uploaded), `enforce` moves on to the next least recently used one then.
+using Evictor = std::function<bool()>;
+
+auto inline constexpr default_budget = std::size_t(1024) * 1024 * 1024;
+
+[[nodiscard]] auto category_name(Category category) -> char const*;
+
+// Of an image with its whole mip chain, which adds about a third, for textures calling `glGenerateMipmap`.
+[[nodiscard]] auto constexpr with_mips(std::size_t const size) -> std::size_t
+{
+  return size + size / 3;
+}
+
+// Without an `evictor` the allocation is pinned: counted, but never evicted.
+// Objects that keep their GL storage for the life of the process have no use for the id.
+auto track(Category category, std::size_t size, std::string label, Evictor evictor = {}) -> AllocationId;
+
+auto resize(AllocationId allocation, std::size_t size) -> void;
+
+auto release(AllocationId allocation) -> void;
+
+// Marks the allocation as used in this frame. Anything used in the last frame is likely still on screen and never evicted.
+auto touch(AllocationId allocation) -> void;
+
+auto set_budget(std::size_t budget) -> void;
+
+[[nodiscard]] auto budget() -> std::size_t;
+
+// Whether `size` more bytes still fit in the budget, for allocations that can be put off (like finer mips) to hold back.
+[[nodiscard]] auto fits(std::size_t size) -> bool;
+
+// Once per frame, before anything is drawn. Returns how many allocations were evicted.
+auto enforce() -> std::size_t;
+
+[[nodiscard]] auto report() -> std::string;
+
+} // namespace gpu_memory
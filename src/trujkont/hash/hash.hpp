@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+// FNV-1a, 64 bit. Not meant to withstand anyone trying to collide it, only to key caches by content cheaply and stably,
+// which `std::hash` does not promise across runs.
+namespace hash
+{
+
+auto inline constexpr fnv1a64_offset = std::uint64_t(14695981039346656037ULL);
+auto inline constexpr fnv1a64_prime = std::uint64_t(1099511628211ULL);
+
+// `seed` lets several pieces be hashed one after another, as if they were a single one.
+[[nodiscard]] constexpr auto fnv1a64(std::string_view const bytes, std::uint64_t seed = fnv1a64_offset) noexcept -> std::uint64_t
+{
+  for(auto const byte : bytes) {
+    seed ^= static_cast<std::uint8_t>(byte);
+    seed *= fnv1a64_prime;
+  }
+
+  return seed;
+}
+
+[[nodiscard]] inline auto fnv1a64(std::span<std::byte const> const bytes, std::uint64_t seed = fnv1a64_offset) noexcept -> std::uint64_t
+{
+  for(auto const byte : bytes) {
+    seed ^= static_cast<std::uint8_t>(byte);
+    seed *= fnv1a64_prime;
+  }
+
+  return seed;
+}
+
+// Hashes the integer's bytes in a fixed (little endian) order, so the result does not depend on the platform.
+[[nodiscard]] constexpr auto fnv1a64(std::uint64_t value, std::uint64_t seed = fnv1a64_offset) noexcept -> std::uint64_t
+{
+  for(auto i = 0; i < 8; ++i) {
+    seed ^= value & 0xFFU;
+    seed *= fnv1a64_prime;
+    value >>= 8U;
+  }
+
+  return seed;
+}
+
+static_assert(fnv1a64(std::string_view("")) == fnv1a64_offset);
+static_assert(fnv1a64(std::string_view("a")) == 0xAF63DC4C8601EC8CULL);
+
+} // namespace hash
@@ -0,0 +1,132 @@
+#include <utility>
+
+#include "trujkont/instanced_cubes/instanced_cubes.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+InstancedCubes::InstancedCubes()
+{
+  glGenVertexArrays(1, &VAO);
+  gl_state::bind_vertex_array(VAO);
+
+  glGenBuffers(1, &VBO);
+  gl_state::bind_buffer(GL_ARRAY_BUFFER, VBO);
+
+  CubeLayout::setup();
+
+  glGenBuffers(1, &EBO);
+  gl_state::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+  for(auto column = 0; column < 4; ++column) {
+    auto const location = static_cast<GLuint>(model_attr_location + column);
+
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
+  }
+
+  upload_vertices();
+}
+
+InstancedCubes::~InstancedCubes()
+{
+  gpu_memory::release(allocation);
+
+  gl_state::forget_vertex_array(VAO);
+  gl_state::forget_buffer(VBO);
+  gl_state::forget_buffer(EBO);
+
+  glDeleteVertexArrays(1, &VAO);
+  glDeleteBuffers(1, &VBO);
+  glDeleteBuffers(1, &EBO);
+}
+
+auto InstancedCubes::draw(GLuint const instance_buffer, GLintptr const instances_offset, std::size_t const instances_count) -> void
+{
+  if(instances_count == 0) return;
+
+  if(allocation == 0) upload_vertices();
+  gpu_memory::touch(allocation);
+
+  gl_state::bind_vertex_array(VAO);
+  point_instances_at(instance_buffer, instances_offset);
+
+  glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(index_count), IndexedMesh<CubeVertex>::index_type, nullptr, static_cast<GLsizei>(instances_count));
+}
+
+auto InstancedCubes::draw_indirect(GLuint const instance_buffer, GLuint const command_buffer) -> void
+{
+  if(allocation == 0) upload_vertices();
+  gpu_memory::touch(allocation);
+
+  gl_state::bind_vertex_array(VAO);
+  point_instances_at(instance_buffer, 0);
+
+  gl_state::bind_buffer(GL_DRAW_INDIRECT_BUFFER, command_buffer);
+  glDrawElementsIndirect(GL_TRIANGLES, IndexedMesh<CubeVertex>::index_type, nullptr);
+}
+
+auto InstancedCubes::point_instances_at(GLuint const instance_buffer, GLintptr const instances_offset) -> void
+{
+  if(instance_buffer == instances_source and instances_offset == instances_source_offset) return;
+
+  instances_source = instance_buffer;
+  instances_source_offset = instances_offset;
+
+  gl_state::bind_buffer(GL_ARRAY_BUFFER, instance_buffer);
+
+  // A mat4 attribute takes up four consecutive locations, one vec4 column each, advanced once per instance.
+  for(auto column = 0; column < 4; ++column) {
+    auto const location = static_cast<GLuint>(model_attr_location + column);
+    auto const offset = static_cast<std::size_t>(instances_offset) + column * sizeof(glm::vec4);
+
+    // NOLINTNEXTLINE
+    glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<void*>(offset));
+  }
+}
+
+auto InstancedCubes::upload_vertices() -> void
+{
+  // Through a target no vertex array captures, `GL_ARRAY_BUFFER` may be left pointing at the instances.
+  auto const& cube = mesh();
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, VBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(cube.vertices_size()), cube.vertices.data(), GL_STATIC_DRAW);
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, EBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(cube.indices_size()), cube.indices.data(), GL_STATIC_DRAW);
+
+  allocation = gpu_memory::track(gpu_memory::Category::Mesh, cube.vertices_size() + cube.indices_size(), "cube", [this] {
+    evict_vertices();
+    return true;
+  });
+}
+
+auto InstancedCubes::evict_vertices() -> void
+{
+  for(auto const buffer : { VBO, EBO }) {
+    gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+  }
+
+  gpu_memory::release(std::exchange(allocation, 0));
+}
+
+auto InstancedCubes::mesh() -> IndexedMesh<CubeVertex> const&
+{
+  auto static const indexed = [] {
+    auto triangles = std::array<CubeVertex, index_count>();
+
+    for(auto i = std::size_t(0); i < triangles.size(); ++i) {
+      auto const* const vertex = vertices.data() + i * attrs_per_vertex;
+
+      triangles[i] = CubeVertex {
+        .position = Snorm16x3::pack(glm::vec3(vertex[0], vertex[1], vertex[2]) / half_extent),
+        .texture_coords = Half2::pack(glm::vec2(vertex[3], vertex[4])),
+      };
+    }
+
+    return index_vertices(std::span<CubeVertex const>(triangles));
+  }();
+
+  return indexed;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+
+#include "trujkont/vertex_layout/indexed_mesh.hpp"
+#include "trujkont/vertex_layout/vertex_layout.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+
+struct CubeVertex
+{
+  // In units of `InstancedCubes::half_extent`.
+  Snorm16x3 position;
+  Half2 texture_coords;
+};
+
+using CubeLayout = VertexLayout<
+  CubeVertex,
+  VertexAttribute<0, Snorm16x3, offsetof(CubeVertex, position)>,
+  VertexAttribute<1, Half2, offsetof(CubeVertex, texture_coords)>>;
+
+// Draws any number of textured unit cubes with a single instanced draw call.
+// Every instance is described only by its model matrix, sourced per instance from a tightly packed array of `glm::mat4`
+// in any buffer (attribute locations `model_attr_location` .. `model_attr_location + 3`, one per matrix column).
+// The cube is drawn from its 24 distinct packed vertices and 16 bit indices, 12 bytes a vertex instead of 20.
+// Its buffers are evictable by `gpu_memory`, they are uploaded again by the next draw.
+class InstancedCubes
+{
+public:
+  InstancedCubes();
+
+  InstancedCubes(InstancedCubes const&) = delete;
+  InstancedCubes(InstancedCubes&&) = delete;
+  auto operator=(InstancedCubes const&) -> InstancedCubes& = delete;
+  auto operator=(InstancedCubes&&) -> InstancedCubes& = delete;
+
+  ~InstancedCubes();
+
+  auto draw(GLuint instance_buffer, GLintptr instances_offset, std::size_t instances_count) -> void;
+
+  // Instances start at the beginning of `instance_buffer`, their count comes from the `DrawElementsIndirectCommand`
+  // at the beginning of `command_buffer`, which is how GPU culling feeds the draw without a round trip to the CPU.
+  auto draw_indirect(GLuint instance_buffer, GLuint command_buffer) -> void;
+
+  auto inline static constexpr model_attr_location = 3;
+  static_assert(CubeLayout::first_free_location <= model_attr_location);
+
+  // Of the sphere around the unscaled cube, half its diagonal.
+  auto inline static constexpr bounding_radius = 0.8660254F;
+
+  auto inline static constexpr index_count = GLuint(36);
+
+  // Of the unit cube, which the vertex shader multiplies the stored positions by.
+  auto inline static constexpr half_extent = 0.5F;
+
+private:
+  auto point_instances_at(GLuint instance_buffer, GLintptr instances_offset) -> void;
+
+  auto upload_vertices() -> void;
+
+  // Only the buffers' stores are freed, the vertex array keeps pointing at the same buffers for when they're uploaded again.
+  auto evict_vertices() -> void;
+
+  GLuint VAO = 0;
+  GLuint VBO = 0;
+  GLuint EBO = 0;
+
+  gpu_memory::AllocationId allocation = 0;
+
+  GLuint instances_source = 0;
+  GLintptr instances_source_offset = -1;
+
+  // Position and texture coordinates of every triangle's corners, packed and indexed when uploaded.
+  auto inline static constexpr attrs_per_vertex = 5;
+
+  // clang-format off
+  inline static auto constexpr vertices = std::array {
+      -0.5F, -0.5F, -0.5F,  0.0F, 0.0F,
+      0.5F, -0.5F, -0.5F,  1.0F, 0.0F,
+      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
+      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
+      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F,
+      -0.5F, -0.5F, -0.5F,  0.0F, 0.0F,
+
+      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
+      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
+      0.5F,  0.5F,  0.5F,  1.0F, 1.0F,
+      0.5F,  0.5F,  0.5F,  1.0F, 1.0F,
+      -0.5F,  0.5F,  0.5F,  0.0F, 1.0F,
+      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
+
+      -0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+      -0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
+      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
+      -0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+
+      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
+      0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+      0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+      0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
+      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+
+      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+      0.5F, -0.5F, -0.5F,  1.0F, 1.0F,
+      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
+      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
+      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
+      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
+
+      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F,
+      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
+      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
+      -0.5F,  0.5F,  0.5F,  0.0F, 0.0F,
+      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F
+  };
+  // clang-format on
+
+  static_assert(vertices.size() == index_count * attrs_per_vertex);
+
+  // Packed and indexed once, on the first upload.
+  [[nodiscard]] auto static mesh() -> IndexedMesh<CubeVertex> const&;
+};
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <numbers>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <thread>
+
+#include "trujkont/jobs/job_benchmark.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+#include "trujkont/transform/transform_store.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr runs = 5;
+auto constexpr grain = std::size_t(4096);
+
+} // namespace
+
+auto benchmark_jobs(std::size_t const transforms_count) -> std::string
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto generator = std::mt19937(2137); // NOLINT
+  auto coordinate = std::uniform_real_distribution(-100.0F, 100.0F);
+  auto angle = std::uniform_real_distribution(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+
+  auto transforms = TransformStore();
+  transforms.reserve(transforms_count);
+
+  for(auto i = std::size_t(0); i < transforms_count; ++i) {
+    transforms.push(
+      glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)),
+      glm::vec3(0., 1., 0.),
+      angle(generator)
+    );
+  }
+
+  auto models = std::vector<glm::mat4>(transforms_count);
+
+  auto const cores = std::max(std::thread::hardware_concurrency(), 1U);
+  auto report = fmt::format("{} transforms in chunks of {}, {} hardware threads, best of {} runs\n", transforms_count, grain, cores, runs);
+
+  auto single_worker_time = 0.0;
+
+  for(auto const workers_count : { 1U, 2U, 4U, 8U, 16U }) {
+    if(workers_count > cores) {
+      report += fmt::format("{:>3} workers: skipped, not enough cores\n", workers_count);
+      continue;
+    }
+
+    auto jobs = JobSystem(workers_count);
+    auto best = std::chrono::duration<double, std::milli>::max();
+
+    for(auto run = 0; run < runs; ++run) {
+      auto const start = Clock::now();
+
+      // Everything goes through the workers, so the main thread doesn't skew the scaling by helping.
+      auto done = JobCounter();
+      jobs.submit(
+        [&] {
+          auto chunks = JobCounter();
+          jobs.parallel_for(
+            0,
+            transforms_count,
+            grain,
+            [&](std::size_t const begin, std::size_t const end) {
+              write_model_matrices(transforms, begin, std::span(models).subspan(begin, end - begin), SimdLevel::Scalar);
+            },
+            chunks
+          );
+          jobs.wait(chunks);
+        },
+        &done
+      );
+
+      while(not done.done()) std::this_thread::yield();
+      jobs.wait(done);
+
+      best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start));
+    }
+
+    if(workers_count == 1) single_worker_time = best.count();
+
+    report += fmt::format("{:>3} workers: {:8.3f} ms, {:5.2f}x\n", workers_count, best.count(), single_worker_time / best.count());
+  }
+
+  return report;
+}
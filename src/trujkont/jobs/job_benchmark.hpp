@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Times the same parallel batch of model matrix updates on job systems with 1, 2, 4, 8 and 16 workers
+// (as far as the machine has cores) and reports the speedup over a single worker.
+auto benchmark_jobs(std::size_t transforms_count) -> std::string;
@@ -0,0 +1,199 @@
+#include "trujkont/jobs/job_system.hpp"
+
+namespace
+{
+
+auto constexpr not_a_worker = ~std::size_t(0);
+
+// Which worker of which system the current thread is, so jobs submitted from inside jobs land in that worker's own deque.
+thread_local auto current_worker = not_a_worker;
+thread_local JobSystem const* current_system = nullptr;
+
+// Steal attempts a worker makes before it goes to sleep.
+auto constexpr spins_before_sleeping = 64;
+
+} // namespace
+
+auto JobCounter::done() const noexcept -> bool
+{
+  return pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(std::size_t const workers_count)
+{
+  auto const count = std::max(workers_count, std::size_t(1));
+
+  workers.reserve(count);
+  for(auto i = std::size_t(0); i < count; ++i) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+
+  threads.reserve(count);
+  for(auto i = std::size_t(0); i < count; ++i) {
+    threads.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    auto const lock = std::lock_guard(sleep_mutex);
+    stopping = true;
+  }
+
+  wake_up.notify_all();
+  threads.clear();
+}
+
+auto JobSystem::submit(Job job, JobCounter* const counter) -> void
+{
+  if(counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+  push(Task { std::move(job), counter });
+}
+
+auto JobSystem::submit_after(JobCounter& dependency, Job job, JobCounter* const counter) -> void
+{
+  if(counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+  {
+    auto const lock = std::lock_guard(dependency.continuations_mutex);
+
+    if(not dependency.done()) {
+      dependency.continuations.push_back(Task { std::move(job), counter });
+      return;
+    }
+  }
+
+  push(Task { std::move(job), counter });
+}
+
+auto JobSystem::wait(JobCounter& counter) -> void
+{
+  auto const own_index = current_system == this ? current_worker : std::size_t(0);
+
+  while(not counter.done()) {
+    if(not try_take(own_index)) std::this_thread::yield();
+  }
+
+  // The last job might still be releasing the counter's lock, don't let the caller destroy it under its feet.
+  auto const lock = std::lock_guard(counter.continuations_mutex);
+}
+
+auto JobSystem::workers_count() const noexcept -> std::size_t
+{
+  return workers.size();
+}
+
+auto JobSystem::default_workers_count() -> std::size_t
+{
+  // One core is left for the render thread.
+  auto const cores = std::thread::hardware_concurrency();
+
+  return cores > 1 ? cores - 1 : 1;
+}
+
+auto JobSystem::push(Task task) -> void
+{
+  auto const index = current_system == this
+                       ? current_worker
+                       : next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+  {
+    auto& worker = *workers[index];
+    auto const lock = std::lock_guard(worker.mutex);
+
+    worker.tasks.push_back(std::move(task));
+  }
+
+  queued.fetch_add(1, std::memory_order_release);
+
+  // Taking the lock orders this against a worker checking `queued` right before it goes to sleep.
+  { auto const lock = std::lock_guard(sleep_mutex); }
+  wake_up.notify_one();
+}
+
+auto JobSystem::try_take(std::size_t const own_index) -> bool
+{
+  auto task = Task();
+  auto found = false;
+
+  {
+    auto& own = *workers[own_index];
+    auto const lock = std::lock_guard(own.mutex);
+
+    if(not own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  for(auto offset = std::size_t(1); not found and offset < workers.size(); ++offset) {
+    auto& victim = *workers[(own_index + offset) % workers.size()];
+    auto const lock = std::lock_guard(victim.mutex);
+
+    if(not victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if(not found) return false;
+
+  queued.fetch_sub(1, std::memory_order_relaxed);
+  run(task);
+
+  return true;
+}
+
+auto JobSystem::run(Task& task) -> void
+{
+  task.job();
+
+  auto* const counter = task.counter;
+  if(not counter) return;
+
+  auto ready = std::vector<Task>();
+
+  {
+    auto const lock = std::lock_guard(counter->continuations_mutex);
+
+    if(counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      ready.swap(counter->continuations);
+    }
+  }
+
+  // The counter may be gone by now, only the local copies are touched from here on.
+  for(auto& continuation : ready) {
+    push(std::move(continuation));
+  }
+}
+
+auto JobSystem::worker_loop(std::size_t const index) -> void
+{
+  current_worker = index;
+  current_system = this;
+
+  auto idle_spins = 0;
+
+  while(true) {
+    if(try_take(index)) {
+      idle_spins = 0;
+      continue;
+    }
+
+    if(++idle_spins < spins_before_sleeping) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    idle_spins = 0;
+
+    auto lock = std::unique_lock(sleep_mutex);
+    wake_up.wait(lock, [this] { return stopping or queued.load(std::memory_order_acquire) > 0; });
+
+    if(stopping) return;
+  }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <condition_variable>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <deque>
+#include <mutex>
+
+using Job = std::function<void()>;
+
+// Counts the unfinished jobs submitted against it. Jobs can be chained after a counter with `JobSystem::submit_after`,
+// they're started as soon as it drops to zero.
+// A counter has to outlive its jobs, so only destroy it after `JobSystem::wait` on it returned.
+class JobCounter
+{
+public:
+  JobCounter() = default;
+
+  JobCounter(JobCounter const&) = delete;
+  JobCounter(JobCounter&&) = delete;
+  auto operator=(JobCounter const&) -> JobCounter& = delete;
+  auto operator=(JobCounter&&) -> JobCounter& = delete;
+
+  ~JobCounter() = default;
+
+  [[nodiscard]] auto done() const noexcept -> bool;
+
+private:
+  friend class JobSystem;
+
+  struct Task
+  {
+    Job job;
+    JobCounter* counter = nullptr;
+  };
+
+  std::atomic<std::size_t> pending = 0;
+
+  std::mutex continuations_mutex;
+  std::vector<Task> continuations;
+};
+
+// Fixed pool of workers, each with its own deque: a worker pushes and pops its own work at the back (newest first,
+// still warm in cache) and, once it runs dry, steals the oldest work from the front of the others' deques.
+// Jobs submitted from outside the pool are spread over the workers round robin.
+// Threads waiting on a counter (including the main thread) run pending jobs meanwhile instead of blocking.
+class JobSystem
+{
+public:
+  explicit JobSystem(std::size_t workers_count = default_workers_count());
+
+  JobSystem(JobSystem const&) = delete;
+  JobSystem(JobSystem&&) = delete;
+  auto operator=(JobSystem const&) -> JobSystem& = delete;
+  auto operator=(JobSystem&&) -> JobSystem& = delete;
+
+  ~JobSystem();
+
+  auto submit(Job job, JobCounter* counter = nullptr) -> void;
+
+  // Runs `job` only once every job of `dependency` finished.
+  auto submit_after(JobCounter& dependency, Job job, JobCounter* counter = nullptr) -> void;
+
+  // Calls `function(chunk_begin, chunk_end)` for consecutive chunks of at most `grain` elements of [begin, end).
+  // The last chunk is run right away on the calling thread, so small ranges don't pay for any scheduling at all.
+  template<typename Function>
+  auto parallel_for(std::size_t const begin, std::size_t const end, std::size_t const grain, Function const& function, JobCounter& counter) -> void
+  {
+    if(begin >= end) return;
+
+    auto const chunk = std::max(grain, std::size_t(1));
+
+    auto chunk_begin = begin;
+    for(; end - chunk_begin > chunk; chunk_begin += chunk) {
+      submit([function, chunk_begin, chunk] { function(chunk_begin, chunk_begin + chunk); }, &counter);
+    }
+
+    function(chunk_begin, end);
+  }
+
+  // Runs other jobs until every job of `counter` is done.
+  auto wait(JobCounter& counter) -> void;
+
+  [[nodiscard]] auto workers_count() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto static default_workers_count() -> std::size_t;
+
+private:
+  using Task = JobCounter::Task;
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  auto push(Task task) -> void;
+
+  [[nodiscard]] auto try_take(std::size_t own_index) -> bool;
+
+  auto run(Task& task) -> void;
+
+  auto worker_loop(std::size_t index) -> void;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::jthread> threads;
+
+  std::atomic<std::size_t> next_worker = 0;
+  std::atomic<std::size_t> queued = 0;
+
+  std::mutex sleep_mutex;
+  std::condition_variable wake_up;
+  bool stopping = false;
+};
@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <array>
+
+#include "trujkont/mipmaps/mip_cache.hpp"
+#include "trujkont/asset_pack/asset_pack.hpp"
+#include "trujkont/pixels/pixels.hpp"
+#include "trujkont/hash/hash.hpp"
+
+#include <fmt/format.h>
+
+#include "stb/stb_image.h"
+
+namespace
+{
+
+auto constexpr file_magic = std::array { 'T', 'R', 'J', 'K', 'M', 'I', 'P', 'S' };
+auto constexpr file_version = std::uint32_t(1);
+
+// Enough for a 2^31 sized image, anything above is a corrupt header.
+auto constexpr max_levels_count = std::uint32_t(32);
+
+struct FileHeader
+{
+  std::array<char, 8> magic = file_magic;
+  std::uint32_t version = file_version;
+  std::uint32_t width = 0;
+  std::uint32_t height = 0;
+  std::uint32_t levels_count = 0;
+  std::uint64_t key = 0;
+  std::uint64_t reserved = 0;
+};
+
+static_assert(sizeof(FileHeader) == 40);
+
+auto cache_hits = std::atomic<std::uint64_t>(0);
+auto chains_generated = std::atomic<std::uint64_t>(0);
+auto generating_microseconds = std::atomic<std::uint64_t>(0);
+
+auto level_extent(int const extent, std::size_t const level) -> int
+{
+  return std::max(extent >> level, 1);
+}
+
+auto level_size(int const width, int const height, std::size_t const level) -> std::size_t
+{
+  return static_cast<std::size_t>(level_extent(width, level)) * static_cast<std::size_t>(level_extent(height, level)) * 4;
+}
+
+auto full_levels_count(int const width, int const height) -> std::size_t
+{
+  auto count = std::size_t(1);
+  while(level_extent(width, count - 1) > 1 or level_extent(height, count - 1) > 1) ++count;
+
+  return count;
+}
+
+auto read_file(std::filesystem::path const& path) -> tl::optional<std::vector<std::byte>>
+{
+  auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+  if(not file) return tl::nullopt;
+
+  auto bytes = std::vector<std::byte>(static_cast<std::size_t>(file.tellg()));
+
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT
+
+  if(not file) return tl::nullopt;
+
+  return bytes;
+}
+
+// Written next to the final file and renamed over it, so a crash or another instance never leaves half a cache behind.
+// The temporary name is unique to the writing thread and moment, jobs caching the same source at once would otherwise
+// interleave their bytes in one temporary and rename a mix of both.
+auto write_file(std::filesystem::path const& path, std::span<std::byte const> const bytes) -> bool
+{
+  auto const thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto const ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+
+  auto temporary = path;
+  temporary += fmt::format(".{:x}.{:x}.tmp", thread, ticks);
+
+  auto error = std::error_code();
+
+  {
+    auto file = std::ofstream(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT
+
+    if(not file) {
+      file.close();
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temporary, path, error);
+  if(not error) return true;
+
+  std::filesystem::remove(temporary, error);
+  return false;
+}
+
+// The encoded image, from the pack if it's there.
+auto read_source(std::filesystem::path const& source) -> tl::expected<std::vector<std::byte>, std::string>
+{
+  if(auto const packed = assets::find(source)) return std::vector<std::byte>(packed->begin(), packed->end());
+
+  auto bytes = read_file(source);
+  if(not bytes) return tl::make_unexpected(fmt::format("Cannot find texture @ \"{}\".", source.c_str()));
+
+  return *std::move(bytes);
+}
+
+auto read_cache(std::filesystem::path const& source, std::uint64_t const key) -> tl::expected<std::vector<MipLevel>, std::string>
+{
+  auto const path = mip_cache_path(source);
+
+  if(auto const packed = assets::find(path)) return parse_mip_cache(*packed, key);
+
+  auto const bytes = read_file(path);
+  if(not bytes) return tl::make_unexpected(fmt::format("No mip cache @ \"{}\"", path.c_str()));
+
+  return parse_mip_cache(*bytes, key);
+}
+
+} // namespace
+
+auto mip_cache_path(std::filesystem::path const& source) -> std::filesystem::path
+{
+  auto path = source;
+  path += mip_cache_extension;
+
+  return path;
+}
+
+auto mip_cache_key(std::span<std::byte const> const source, MipSettings const& settings) -> std::uint64_t
+{
+  auto key = hash::fnv1a64(source);
+  key = hash::fnv1a64(static_cast<std::uint64_t>(settings.filter), key);
+  key = hash::fnv1a64(static_cast<std::uint64_t>(settings.srgb), key);
+  key = hash::fnv1a64(static_cast<std::uint64_t>(settings.opaque), key);
+
+  auto reference_bits = std::uint32_t(0);
+  if(settings.alpha_reference) std::memcpy(&reference_bits, &*settings.alpha_reference, sizeof(reference_bits));
+
+  key = hash::fnv1a64(static_cast<std::uint64_t>(settings.alpha_reference.has_value()), key);
+  key = hash::fnv1a64(static_cast<std::uint64_t>(reference_bits), key);
+
+  return hash::fnv1a64(static_cast<std::uint64_t>(file_version), key);
+}
+
+auto serialize_mip_cache(std::span<MipLevel const> const levels, std::uint64_t const key) -> std::vector<std::byte>
+{
+  if(levels.empty()) throw std::invalid_argument("A mip chain needs at least one level");
+
+  auto const width = levels.front().width;
+  auto const height = levels.front().height;
+
+  if(levels.size() != full_levels_count(width, height)) {
+    throw std::invalid_argument(fmt::format("A {}x{} image has {} levels, got {}", width, height, full_levels_count(width, height), levels.size()));
+  }
+
+  auto const header = FileHeader {
+    .width = static_cast<std::uint32_t>(width),
+    .height = static_cast<std::uint32_t>(height),
+    .levels_count = static_cast<std::uint32_t>(levels.size()),
+    .key = key,
+  };
+
+  auto size = sizeof(header);
+
+  for(auto level = std::size_t(0); level < levels.size(); ++level) {
+    auto const expected_size = level_size(width, height, level);
+
+    if(levels[level].pixels.size() != expected_size) {
+      throw std::invalid_argument(fmt::format("Level {} has {} bytes, expected {}", level, levels[level].pixels.size(), expected_size));
+    }
+
+    size += expected_size;
+  }
+
+  auto bytes = std::vector<std::byte>(size);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+
+  auto offset = static_cast<std::ptrdiff_t>(sizeof(header));
+
+  for(auto const& level : levels) {
+    std::ranges::copy(level.pixels, bytes.begin() + offset);
+    offset += static_cast<std::ptrdiff_t>(level.pixels.size());
+  }
+
+  return bytes;
+}
+
+auto parse_mip_cache(std::span<std::byte const> const bytes, std::uint64_t const key) -> tl::expected<std::vector<MipLevel>, std::string>
+{
+  auto header = FileHeader();
+  if(bytes.size() < sizeof(header)) return tl::make_unexpected("Too short for a mip cache header");
+
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if(header.magic != file_magic) return tl::make_unexpected("Not a mip cache");
+
+  if(header.version != file_version) {
+    return tl::make_unexpected(fmt::format("Mip cache version {}, expected {}", header.version, file_version));
+  }
+
+  if(header.key != key) return tl::make_unexpected("Stale mip cache");
+
+  auto constexpr max_extent = std::uint32_t(1) << 30U;
+
+  if(header.width == 0 or header.height == 0 or header.width > max_extent or header.height > max_extent) {
+    return tl::make_unexpected(fmt::format("Invalid mip cache size {}x{}", header.width, header.height));
+  }
+
+  auto const width = static_cast<int>(header.width);
+  auto const height = static_cast<int>(header.height);
+
+  if(header.levels_count > max_levels_count or header.levels_count != full_levels_count(width, height)) {
+    return tl::make_unexpected(fmt::format("A {}x{} image has {} levels, the cache {}", width, height, full_levels_count(width, height), header.levels_count));
+  }
+
+  auto levels = std::vector<MipLevel>();
+  levels.reserve(header.levels_count);
+
+  auto offset = sizeof(header);
+
+  for(auto level = std::size_t(0); level < header.levels_count; ++level) {
+    auto const size = level_size(width, height, level);
+
+    if(size > bytes.size() - offset) {
+      return tl::make_unexpected(fmt::format("Level {} at [{}, {}) is out of the cache's {} bytes", level, offset, offset + size, bytes.size()));
+    }
+
+    auto const pixels = bytes.subspan(offset, size);
+
+    levels.push_back(MipLevel {
+      .pixels = { pixels.begin(), pixels.end() },
+      .width = level_extent(width, level),
+      .height = level_extent(height, level),
+    });
+
+    offset += size;
+  }
+
+  return levels;
+}
+
+auto load_mip_chain(JobSystem& jobs, std::filesystem::path const& source, MipSettings const& settings)
+  -> tl::expected<std::vector<MipLevel>, std::string>
+{
+  auto const encoded = read_source(source);
+  if(not encoded) return tl::make_unexpected(encoded.error());
+
+  auto const key = mip_cache_key(*encoded, settings);
+
+  if(auto cached = read_cache(source, key)) {
+    cache_hits.fetch_add(1, std::memory_order_relaxed);
+    return cached;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+
+  auto width = 0;
+  auto height = 0;
+  auto channels_number = 0;
+  auto const channels = settings.opaque ? 3 : 4;
+
+  auto const data = std::unique_ptr<stbi_uc, decltype(&stbi_image_free)>(
+    stbi_load_from_memory(
+      reinterpret_cast<stbi_uc const*>(encoded->data()), // NOLINT
+      static_cast<int>(encoded->size()),
+      &width,
+      &height,
+      &channels_number,
+      channels
+    ),
+    &stbi_image_free
+  );
+
+  if(not data) return tl::make_unexpected(fmt::format("Cannot decode texture @ \"{}\": {}.", source.c_str(), stbi_failure_reason()));
+
+  auto const pixels_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  auto const decoded = std::span(reinterpret_cast<std::byte const*>(data.get()), pixels_count * static_cast<std::size_t>(channels)); // NOLINT
+
+  // Opaque images are decoded to RGB, where stb doesn't spend time on an alpha channel, and expanded here.
+  auto rgba = std::vector<std::byte>();
+
+  if(settings.opaque) {
+    rgba.resize(pixels_count * 4);
+    expand_rgb(decoded, rgba);
+  }
+
+  auto const image = RgbaView { .pixels = settings.opaque ? std::span<std::byte const>(rgba) : decoded, .width = width, .height = height };
+  auto levels = generate_mips(jobs, image, settings);
+
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  chains_generated.fetch_add(1, std::memory_order_relaxed);
+  generating_microseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+
+  if(not write_file(mip_cache_path(source), serialize_mip_cache(levels, key))) {
+    fmt::print(stderr, "Cannot write mip cache @ \"{}\".\n", mip_cache_path(source).c_str());
+  }
+
+  return levels;
+}
+
+auto read_mip_cache(std::filesystem::path const& source, MipSettings const& settings) -> tl::expected<std::vector<MipLevel>, std::string>
+{
+  auto const encoded = read_source(source);
+  if(not encoded) return tl::make_unexpected(encoded.error());
+
+  auto cached = read_cache(source, mip_cache_key(*encoded, settings));
+  if(cached) cache_hits.fetch_add(1, std::memory_order_relaxed);
+
+  return cached;
+}
+
+auto mip_cache_report() -> std::string
+{
+  auto const generated = chains_generated.load(std::memory_order_relaxed);
+
+  return fmt::format(
+    "mip chains: {} from the cache, {} generated in {:.1f} ms",
+    cache_hits.load(std::memory_order_relaxed),
+    generated,
+    static_cast<double>(generating_microseconds.load(std::memory_order_relaxed)) / 1000.0
+  );
+}
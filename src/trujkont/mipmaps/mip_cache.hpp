@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <span>
+
+#include <tl/expected.hpp>
+
+#include "trujkont/mipmaps/mip_chain.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+// Generated mip chains, cached next to the image they were generated from, so only the first launch after the image
+// (or the settings) changed pays for decoding and filtering it.
+//
+// Layout, little endian: a 40 byte header, then every level's RGBA rows back to back, largest first.
+// The key in the header hashes the image's encoded bytes and the settings, a cache with another key is stale.
+// Levels are stored as `load_image` decoded the image, flipped if stb is set to flip (which the game always is).
+
+auto inline constexpr mip_cache_extension = std::string_view(".tmip");
+
+// `assets/face.png` is cached in `assets/face.png.tmip`, which the asset pack can carry like any other file.
+[[nodiscard]] auto mip_cache_path(std::filesystem::path const& source) -> std::filesystem::path;
+
+[[nodiscard]] auto mip_cache_key(std::span<std::byte const> source, MipSettings const& settings) -> std::uint64_t;
+
+// `levels` are `generate_mips` outputs.
+[[nodiscard]] auto serialize_mip_cache(std::span<MipLevel const> levels, std::uint64_t key) -> std::vector<std::byte>;
+
+// Fails on anything but a complete chain under `key`.
+[[nodiscard]] auto parse_mip_cache(std::span<std::byte const> bytes, std::uint64_t key) -> tl::expected<std::vector<MipLevel>, std::string>;
+
+// The cached chain of `source`, from the mounted asset pack or next to it. Without a valid one, it's decoded, generated
+// on `jobs` and cached for the next time, a cache that can't be written is only reported on stderr.
+[[nodiscard]] auto load_mip_chain(JobSystem& jobs, std::filesystem::path const& source, MipSettings const& settings = {})
+  -> tl::expected<std::vector<MipLevel>, std::string>;
+
+// Just the cached chain, for callers without a job system to generate one on.
+[[nodiscard]] auto read_mip_cache(std::filesystem::path const& source, MipSettings const& settings = {})
+  -> tl::expected<std::vector<MipLevel>, std::string>;
+
+// Safe to call from any thread.
+[[nodiscard]] auto mip_cache_report() -> std::string;
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <stdexcept>
+#include <numbers>
+#include <cmath>
+#include <span>
+
+#include "trujkont/mipmaps/mip_chain.hpp"
+#include "trujkont/pixels/pixels.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+// Output rows per job. Each tile also decodes the few source rows its filter reaches past its own.
+auto constexpr tile_rows = std::size_t(32);
+
+// In output pixels either side, with the window's shape, the values most mip generators settled on.
+auto constexpr kaiser_radius = 3.0;
+auto constexpr kaiser_beta = 4.0;
+
+// Below it a filtered pixel counts as fully transparent and its color as black.
+auto constexpr min_alpha = 1.0F / 1024.0F;
+
+// The source pixels an output pixel is made of: `weights[k]` applies to `first + k`, clamped to the image.
+struct Taps
+{
+  int first = 0;
+  std::vector<float> weights;
+};
+
+auto sinc(double const x) -> double
+{
+  if(std::abs(x) < 1e-6) return 1.0; // NOLINT(*-magic-numbers)
+
+  return std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+}
+
+// Modified Bessel function of the first kind, order 0, from its series, which converges fast for the arguments a window takes.
+auto bessel_i0(double const x) -> double
+{
+  auto sum = 1.0;
+  auto term = 1.0;
+
+  for(auto k = 1; k < 32; ++k) { // NOLINT(*-magic-numbers)
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+
+    if(term < sum * 1e-12) break; // NOLINT(*-magic-numbers)
+  }
+
+  return sum;
+}
+
+auto kaiser(double const x) -> double
+{
+  auto const ratio = x / kaiser_radius;
+  if(std::abs(ratio) >= 1.0) return 0.0;
+
+  return sinc(x) * bessel_i0(kaiser_beta * std::sqrt(1.0 - ratio * ratio)) / bessel_i0(kaiser_beta);
+}
+
+// Per output pixel along one axis, normalized so flat areas stay flat.
+auto filter_taps(int const source_extent, int const extent, MipFilter const filter) -> std::vector<Taps>
+{
+  auto const scale = static_cast<double>(source_extent) / static_cast<double>(extent);
+  auto taps = std::vector<Taps>(static_cast<std::size_t>(extent));
+
+  for(auto i = 0; i < extent; ++i) {
+    auto& pixel = taps[static_cast<std::size_t>(i)];
+
+    // The output pixel's footprint in source pixels.
+    auto const low = static_cast<double>(i) * scale;
+    auto const high = static_cast<double>(i + 1) * scale;
+    auto const center = (low + high) / 2.0;
+
+    auto const reach = filter == MipFilter::Box ? (high - low) / 2.0 : kaiser_radius * scale;
+
+    pixel.first = static_cast<int>(std::floor(center - reach));
+    auto const last = static_cast<int>(std::ceil(center + reach));
+
+    auto sum = 0.0;
+
+    for(auto source = pixel.first; source < last; ++source) {
+      auto const weight = filter == MipFilter::Box
+        ? std::max(0.0, std::min(high, source + 1.0) - std::max(low, static_cast<double>(source)))
+        : kaiser((source + 0.5 - center) / scale);
+
+      pixel.weights.push_back(static_cast<float>(weight));
+      sum += weight;
+    }
+
+    for(auto& weight : pixel.weights) weight = static_cast<float>(weight / sum);
+  }
+
+  return taps;
+}
+
+// Of the pixels whose alpha is at or above `reference`.
+auto alpha_coverage(std::span<std::byte const> const rgba, float const reference) -> double
+{
+  auto covered = std::size_t(0);
+
+  for(auto i = std::size_t(3); i < rgba.size(); i += 4) {
+    if(static_cast<float>(std::to_integer<int>(rgba[i])) / 255.0F >= reference) ++covered; // NOLINT(*-magic-numbers)
+  }
+
+  return static_cast<double>(covered) / static_cast<double>(rgba.size() / 4);
+}
+
+// What alpha has to be multiplied by for `coverage` of `alphas` to be at or above `reference`.
+auto coverage_scale(std::vector<float> alphas, double const coverage, float const reference) -> float
+{
+  auto const covered = static_cast<std::size_t>(std::lround(coverage * static_cast<double>(alphas.size())));
+  if(covered == 0 or covered >= alphas.size()) return 1.0F;
+
+  // The least opaque of the pixels that have to stay covered is scaled to exactly the reference.
+  auto const nth = alphas.begin() + static_cast<std::ptrdiff_t>(covered - 1);
+  std::ranges::nth_element(alphas, nth, std::ranges::greater());
+
+  return *nth > min_alpha ? reference / *nth : 1.0F;
+}
+
+struct LevelFilter
+{
+  MipLevel const& source;
+  int width = 0;
+  std::vector<Taps> columns;
+  std::vector<Taps> rows;
+  bool srgb = true;
+  SimdLevel level = SimdLevel::Scalar;
+};
+
+// One source row to linear, premultiplied RGBA.
+auto decode_row(LevelFilter const& filter, int const y, std::span<float> const linear) -> void
+{
+  auto const row_size = static_cast<std::size_t>(filter.source.width) * 4;
+  auto const row = std::span(filter.source.pixels).subspan(static_cast<std::size_t>(y) * row_size, row_size);
+
+  if(filter.srgb) {
+    srgb_to_linear(row, linear, filter.level);
+  } else {
+    std::ranges::transform(row, linear.begin(), [](std::byte const value) { return static_cast<float>(std::to_integer<int>(value)) / 255.0F; }); // NOLINT(*-magic-numbers)
+  }
+
+  for(auto i = std::size_t(0); i < linear.size(); i += 4) {
+    for(auto c = std::size_t(0); c < 3; ++c) linear[i + c] *= linear[i + 3];
+  }
+}
+
+// Output rows [begin, end) into `linear`, which holds the whole level: horizontally first, each needed source row once,
+// then vertically.
+auto filter_tile(LevelFilter const& filter, std::size_t const begin, std::size_t const end, std::span<float> const linear) -> void
+{
+  auto const clamp_row = [&](int const y) { return std::clamp(y, 0, filter.source.height - 1); };
+  auto const clamp_column = [&](int const x) { return std::clamp(x, 0, filter.source.width - 1); };
+
+  auto const& last_taps = filter.rows[end - 1];
+  auto const first_row = clamp_row(filter.rows[begin].first);
+  auto const last_row = clamp_row(last_taps.first + static_cast<int>(last_taps.weights.size()) - 1);
+
+  auto const width = static_cast<std::size_t>(filter.width);
+  auto source_row = std::vector<float>(static_cast<std::size_t>(filter.source.width) * 4);
+  auto filtered = std::vector<float>(static_cast<std::size_t>(last_row - first_row + 1) * width * 4);
+
+  for(auto y = first_row; y <= last_row; ++y) {
+    decode_row(filter, y, source_row);
+
+    auto* const out = filtered.data() + static_cast<std::size_t>(y - first_row) * width * 4;
+
+    for(auto x = std::size_t(0); x < width; ++x) {
+      auto const& taps = filter.columns[x];
+
+      for(auto k = std::size_t(0); k < taps.weights.size(); ++k) {
+        auto const* const pixel = source_row.data() + static_cast<std::size_t>(clamp_column(taps.first + static_cast<int>(k))) * 4;
+
+        for(auto c = std::size_t(0); c < 4; ++c) out[x * 4 + c] += pixel[c] * taps.weights[k];
+      }
+    }
+  }
+
+  for(auto y = begin; y < end; ++y) {
+    auto const& taps = filter.rows[y];
+    auto* const out = linear.data() + y * width * 4;
+
+    for(auto k = std::size_t(0); k < taps.weights.size(); ++k) {
+      auto const row = static_cast<std::size_t>(clamp_row(taps.first + static_cast<int>(k)) - first_row);
+      auto const* const in = filtered.data() + row * width * 4;
+
+      for(auto i = std::size_t(0); i < width * 4; ++i) out[i] += in[i] * taps.weights[k];
+    }
+  }
+}
+
+// Rows [begin, end) of `linear` back to straight alpha, then to `level`'s bytes.
+auto encode_rows(
+  std::span<float> const linear,
+  std::size_t const begin,
+  std::size_t const end,
+  float const alpha_scale,
+  bool const srgb,
+  SimdLevel const simd_level,
+  MipLevel& level
+) -> void
+{
+  auto const row_size = static_cast<std::size_t>(level.width) * 4;
+  auto const rows = linear.subspan(begin * row_size, (end - begin) * row_size);
+
+  for(auto i = std::size_t(0); i < rows.size(); i += 4) {
+    auto const alpha = std::clamp(rows[i + 3], 0.0F, 1.0F);
+
+    for(auto c = std::size_t(0); c < 3; ++c) rows[i + c] = alpha > min_alpha ? rows[i + c] / alpha : 0.0F;
+    rows[i + 3] = std::min(alpha * alpha_scale, 1.0F);
+  }
+
+  auto const pixels = std::span(level.pixels).subspan(begin * row_size, rows.size());
+
+  if(srgb) {
+    linear_to_srgb(rows, pixels, simd_level);
+  } else {
+    std::ranges::transform(rows, pixels.begin(), [](float const value) {
+      return std::byte(static_cast<std::uint8_t>(std::clamp(value, 0.0F, 1.0F) * 255.0F + 0.5F)); // NOLINT(*-magic-numbers)
+    });
+  }
+}
+
+} // namespace
+
+auto mip_filter_name(MipFilter const filter) -> char const*
+{
+  switch(filter) {
+    case MipFilter::Box: return "box";
+    case MipFilter::Kaiser: return "kaiser";
+  }
+
+  return "unknown";
+}
+
+auto parse_mip_filter(std::string_view const name) -> tl::optional<MipFilter>
+{
+  for(auto const filter : { MipFilter::Box, MipFilter::Kaiser }) {
+    if(name == mip_filter_name(filter)) return filter;
+  }
+
+  return tl::nullopt;
+}
+
+auto generate_mips(JobSystem& jobs, RgbaView const image, MipSettings const& settings, SimdLevel const level) -> std::vector<MipLevel>
+{
+  auto const pixels_count = static_cast<std::size_t>(std::max(image.width, 0)) * static_cast<std::size_t>(std::max(image.height, 0));
+
+  if(image.width <= 0 or image.height <= 0 or image.pixels.size() != pixels_count * 4) {
+    throw std::invalid_argument(fmt::format("Got {} bytes for a {}x{} RGBA image", image.pixels.size(), image.width, image.height));
+  }
+
+  auto levels = std::vector<MipLevel>();
+  levels.push_back(MipLevel { .pixels = { image.pixels.begin(), image.pixels.end() }, .width = image.width, .height = image.height });
+
+  auto const coverage = settings.alpha_reference ? alpha_coverage(image.pixels, *settings.alpha_reference) : 0.0;
+
+  while(levels.back().width > 1 or levels.back().height > 1) {
+    auto const& source = levels.back();
+    auto const width = std::max(source.width / 2, 1);
+    auto const height = std::max(source.height / 2, 1);
+
+    auto const filter = LevelFilter {
+      .source = source,
+      .width = width,
+      .columns = filter_taps(source.width, width, settings.filter),
+      .rows = filter_taps(source.height, height, settings.filter),
+      .srgb = settings.srgb,
+      .level = level,
+    };
+
+    auto const rows_count = static_cast<std::size_t>(height);
+    auto linear = std::vector<float>(static_cast<std::size_t>(width) * rows_count * 4);
+
+    auto filtering = JobCounter();
+    jobs.parallel_for(0, rows_count, tile_rows, [&filter, &linear](std::size_t const begin, std::size_t const end) { filter_tile(filter, begin, end, linear); }, filtering);
+    jobs.wait(filtering);
+
+    auto alpha_scale = 1.0F;
+
+    if(settings.alpha_reference) {
+      auto alphas = std::vector<float>(linear.size() / 4);
+      for(auto i = std::size_t(0); i < alphas.size(); ++i) alphas[i] = std::clamp(linear[i * 4 + 3], 0.0F, 1.0F);
+
+      alpha_scale = coverage_scale(std::move(alphas), coverage, *settings.alpha_reference);
+    }
+
+    auto mip = MipLevel { .pixels = std::vector<std::byte>(linear.size()), .width = width, .height = height };
+
+    auto encoding = JobCounter();
+    jobs.parallel_for(
+      0,
+      rows_count,
+      tile_rows,
+      [&](std::size_t const begin, std::size_t const end) { encode_rows(linear, begin, end, alpha_scale, settings.srgb, level, mip); },
+      encoding
+    );
+    jobs.wait(encoding);
+
+    levels.push_back(std::move(mip));
+  }
+
+  return levels;
+}
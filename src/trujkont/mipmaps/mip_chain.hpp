@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+#include <vector>
+
+#include <tl/optional.hpp>
+
+#include "trujkont/block_compression/block_compression.hpp"
+#include "trujkont/simd/cpu_features.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+enum class MipFilter
+{
+  // Averages the pixels each one covers, cheap and soft.
+  Box,
+
+  // Windowed sinc, keeps the detail a box blurs away without the aliasing of sampling fewer pixels.
+  Kaiser,
+};
+
+[[nodiscard]] auto mip_filter_name(MipFilter filter) -> char const*;
+
+[[nodiscard]] auto parse_mip_filter(std::string_view name) -> tl::optional<MipFilter>;
+
+struct MipSettings
+{
+  MipFilter filter = MipFilter::Kaiser;
+
+  // Color is sRGB encoded and filtered as linear light, otherwise (normal maps, masks) filtered as it is.
+  bool srgb = true;
+
+  // Images are loaded without their alpha, if they have any, and every pixel is opaque. For textures stored as RGB.
+  bool opaque = false;
+
+  // For alpha tested textures: every level keeps the fraction of pixels with alpha at or above it that the full size
+  // image has, which plain filtering lets shrink until far away foliage and fences vanish.
+  tl::optional<float> alpha_reference;
+};
+
+// Tightly packed RGBA rows, like `RgbaView`.
+struct MipLevel
+{
+  std::vector<std::byte> pixels;
+  int width = 0;
+  int height = 0;
+
+  [[nodiscard]] auto view() const -> RgbaView { return RgbaView { .pixels = pixels, .width = width, .height = height }; }
+};
+
+// Every level of `image` from its own size down to 1x1, each half the size of the previous one (rounded down, at least 1).
+// Levels are filtered from the one before, tiles of rows in parallel on `jobs`, clamping at the edges. Color is weighted
+// by alpha, so the color of transparent pixels never bleeds into the visible ones.
+// Throws `std::invalid_argument` when `image.pixels` doesn't match its size.
+[[nodiscard]] auto generate_mips(JobSystem& jobs, RgbaView image, MipSettings const& settings = {}, SimdLevel level = best_simd_level())
+  -> std::vector<MipLevel>;
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+#include <array>
+
+#include "trujkont/pixels/pixel_benchmark.hpp"
+#include "trujkont/pixels/pixels.hpp"
+#include "trujkont/benchmark/best_time.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr runs = 5;
+
+// Noise, so no kernel gets to skip anything, with every alpha from fully transparent to opaque.
+auto random_bytes(std::size_t const size) -> std::vector<std::byte>
+{
+  auto generator = std::mt19937(2137); // NOLINT
+  auto distribution = std::uniform_int_distribution(0, 255);
+
+  auto bytes = std::vector<std::byte>(size);
+  std::ranges::generate(bytes, [&] { return std::byte(distribution(generator)); });
+
+  return bytes;
+}
+
+} // namespace
+
+auto benchmark_pixels(std::size_t const width) -> std::string
+{
+  auto const pixels_across = std::clamp(width, std::size_t(16), std::size_t(8192));
+  auto const count = pixels_across * (pixels_across * 9 / 16);
+  auto const megapixels = static_cast<double>(count) / 1e6;
+
+  auto const rgb = random_bytes(count * 3);
+  auto const source = random_bytes(count * 4);
+  auto rgba = std::vector<std::byte>(count * 4);
+
+  // Premultiplied over and over in place, which costs the same whatever the values by then.
+  auto premultiplied = source;
+  auto linear = std::vector<float>(count * 4);
+
+  srgb_to_linear(source, linear, SimdLevel::Scalar);
+
+  struct Conversion
+  {
+    char const* name;
+    std::function<void(SimdLevel)> run;
+  };
+
+  auto const conversions = std::array {
+    Conversion { .name = "rgb to rgba", .run = [&](SimdLevel const level) { expand_rgb(rgb, rgba, level); } },
+    Conversion { .name = "premultiply", .run = [&](SimdLevel const level) { premultiply_alpha(premultiplied, level); } },
+    Conversion { .name = "bgra to rgba", .run = [&](SimdLevel const level) { swizzle(source, ChannelOrder { .from = { 2, 1, 0, 3 } }, rgba, level); } },
+    Conversion { .name = "srgb to linear", .run = [&](SimdLevel const level) { srgb_to_linear(source, linear, level); } },
+    Conversion { .name = "linear to srgb", .run = [&](SimdLevel const level) { linear_to_srgb(linear, rgba, level); } },
+  };
+
+  auto report = fmt::format("{}x{} image, best of {} runs\n", pixels_across, count / pixels_across, runs);
+
+  for(auto const& conversion : conversions) {
+    auto scalar_time = 0.0;
+
+    for(auto const level : { SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2 }) {
+      if(level > best_simd_level()) break;
+
+      auto const time = best_time(runs, [&] { conversion.run(level); });
+      if(level == SimdLevel::Scalar) scalar_time = time;
+
+      report += fmt::format(
+        "{:>14} {:>8}: {:8.3f} ms, {:8.2f} MP/s, {:5.2f}x scalar\n",
+        conversion.name,
+        simd_level_name(level),
+        time,
+        megapixels / (time / 1000.0),
+        scalar_time / time
+      );
+    }
+  }
+
+  return report;
+}
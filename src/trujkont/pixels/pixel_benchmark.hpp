@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Runs every pixel conversion with every compiled in kernel over a synthetic `width` wide 16:9 image (3840 is 4K),
+// on one thread, the way the job that decoded an image runs them, and reports the throughput and the speedup over
+// the scalar kernel. Returns a human readable report.
+auto benchmark_pixels(std::size_t width) -> std::string;
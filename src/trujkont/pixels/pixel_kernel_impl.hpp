@@ -0,0 +1,317 @@
+#pragma once
+
+#include "trujkont/pixels/pixel_kernels.hpp"
+#include "trujkont/simd/simd_float.hpp"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+auto constexpr opaque = std::uint8_t(255);
+
+// Below it the sRGB curve is a straight line.
+auto constexpr srgb_toe = 0.0031308F;
+
+// Which of the 4 channels of a pixel is alpha, loaded at any multiple of a vector's width.
+float const alpha_lanes[8] = { 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F }; // NOLINT(*-avoid-c-arrays)
+
+// c * a / 255 rounded to nearest, exact for every pair of bytes, without a division.
+auto multiply_channel(unsigned const color, unsigned const alpha) -> std::uint8_t
+{
+  auto const product = color * alpha + 128U;
+  return static_cast<std::uint8_t>((product + (product >> 8U)) >> 8U);
+}
+
+// The scalar loops, also finishing what doesn't fill a whole vector, from pixel `begin` on.
+
+auto expand_rgb_from(std::uint8_t const* const rgb, std::size_t const begin, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  for(auto i = begin; i < count; ++i) {
+    rgba[i * 4 + 0] = rgb[i * 3 + 0];
+    rgba[i * 4 + 1] = rgb[i * 3 + 1];
+    rgba[i * 4 + 2] = rgb[i * 3 + 2];
+    rgba[i * 4 + 3] = opaque;
+  }
+}
+
+auto premultiply_alpha_from(std::uint8_t* const rgba, std::size_t const begin, std::size_t const count) -> void
+{
+  for(auto i = begin; i < count; ++i) {
+    auto* const pixel = rgba + i * 4;
+
+    for(auto c = 0; c < 3; ++c) pixel[c] = multiply_channel(pixel[c], pixel[3]);
+  }
+}
+
+auto swizzle_from(
+  std::uint8_t const* const source,
+  std::size_t const begin,
+  std::size_t const count,
+  ChannelOrder const& order,
+  std::uint8_t* const destination
+) -> void
+{
+  for(auto i = begin; i < count; ++i) {
+    // Read whole before anything is written, for in place swizzles.
+    std::uint8_t pixel[4]; // NOLINT(*-avoid-c-arrays)
+    std::memcpy(pixel, source + i * 4, sizeof(pixel));
+
+    for(auto c = 0; c < 4; ++c) destination[i * 4 + c] = pixel[order.from[c] & 3U];
+  }
+}
+
+template<typename V>
+auto select(typename V::Float const mask, typename V::Float const if_set, typename V::Float const otherwise) -> typename V::Float
+{
+  return V::bit_or(V::bit_and(mask, if_set), V::bit_andnot(mask, otherwise));
+}
+
+// A fit of the sRGB curve over chained square roots (the curve is close to x^(1/2.4) away from its toe),
+// which vectorizes where a pow can't.
+template<typename V>
+auto encode_srgb(typename V::Float const linear) -> typename V::Float
+{
+  auto const root = V::sqrt(linear);
+  auto const fourth_root = V::sqrt(root);
+  auto const eighth_root = V::sqrt(fourth_root);
+
+  auto curve = V::fmadd(V::set1(0.653998077F), root, V::set1(-0.00407524316F)); // NOLINT(*-magic-numbers)
+  curve = V::fmadd(V::set1(0.688680359F), fourth_root, curve); // NOLINT(*-magic-numbers)
+  curve = V::fmadd(V::set1(-0.318444014F), eighth_root, curve); // NOLINT(*-magic-numbers)
+  curve = V::fmadd(V::set1(-0.0201908949F), linear, curve); // NOLINT(*-magic-numbers)
+
+  auto const toe = V::mul(V::set1(12.92F), linear); // NOLINT(*-magic-numbers)
+
+  return select<V>(V::less(linear, V::set1(srgb_toe)), toe, curve);
+}
+
+// Channels, not pixels, from `begin` to `end`, which have to be multiples of `V::width`.
+template<typename V>
+auto srgb_to_linear_values(
+  std::uint8_t const* const rgba,
+  std::size_t const begin,
+  std::size_t const end,
+  float const* const decode_table,
+  float* const linear
+) -> void
+{
+  auto const to_unit = V::set1(1.0F / 255.0F); // NOLINT(*-magic-numbers)
+
+  for(auto i = begin; i < end; i += V::width) {
+    auto const bytes = V::load_bytes(rgba + i);
+    auto const alpha = V::less(V::set1(0.5F), V::load(alpha_lanes + i % 4)); // NOLINT(*-magic-numbers)
+
+    V::store(linear + i, select<V>(alpha, V::mul(V::to_float(bytes), to_unit), V::lookup(decode_table, bytes)));
+  }
+}
+
+template<typename V>
+auto linear_to_srgb_values(float const* const linear, std::size_t const begin, std::size_t const end, std::uint8_t* const rgba) -> void
+{
+  auto const zero = V::set1(0.0F);
+  auto const one = V::set1(1.0F);
+
+  for(auto i = begin; i < end; i += V::width) {
+    auto const value = V::max(zero, V::min(V::load(linear + i), one));
+    auto const alpha = V::less(V::set1(0.5F), V::load(alpha_lanes + i % 4)); // NOLINT(*-magic-numbers)
+    auto const encoded = select<V>(alpha, value, encode_srgb<V>(value));
+
+    V::store_bytes(rgba + i, V::truncate(V::fmadd(encoded, V::set1(255.0F), V::set1(0.5F)))); // NOLINT(*-magic-numbers)
+  }
+}
+
+template<typename V>
+auto srgb_to_linear(std::uint8_t const* const rgba, std::size_t const count, float const* const decode_table, float* const linear) -> void
+{
+  auto const values = count * 4;
+  auto const vectorized = values - values % V::width;
+
+  srgb_to_linear_values<V>(rgba, 0, vectorized, decode_table, linear);
+  srgb_to_linear_values<ScalarFloats>(rgba, vectorized, values, decode_table, linear);
+}
+
+template<typename V>
+auto linear_to_srgb(float const* const linear, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  auto const values = count * 4;
+  auto const vectorized = values - values % V::width;
+
+  linear_to_srgb_values<V>(linear, 0, vectorized, rgba);
+  linear_to_srgb_values<ScalarFloats>(linear, vectorized, values, rgba);
+}
+
+// The byte kernels work on integers, which the float abstractions don't cover, so they're written per instruction set.
+
+#if defined(TRUJKONT_SSE_KERNELS)
+
+auto expand_rgb_sse2(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  auto const alpha = _mm_set1_epi32(static_cast<int>(0xFF000000U)); // NOLINT(*-magic-numbers)
+
+  auto i = std::size_t(0);
+
+  // 16 bytes are loaded for 12, so the last pixels are left to the scalar loop.
+  for(; i + 6 <= count; i += 4) {
+    auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(rgb + i * 3)); // NOLINT
+
+    // Each pixel shifted down to the bottom of its own register, the junk above it is cut off by the unpacks.
+    auto const first_two = _mm_unpacklo_epi32(bytes, _mm_srli_si128(bytes, 3));
+    auto const last_two = _mm_unpacklo_epi32(_mm_srli_si128(bytes, 6), _mm_srli_si128(bytes, 9));
+    auto const pixels = _mm_unpacklo_epi64(first_two, last_two);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), _mm_or_si128(pixels, alpha)); // NOLINT
+  }
+
+  expand_rgb_from(rgb, i, count, rgba);
+}
+
+// Two pixels widened to 16 bit channels.
+auto premultiply_words(__m128i const words) -> __m128i
+{
+  auto const alpha_words = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+  auto const keep_alpha = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255); // NOLINT(*-magic-numbers)
+
+  auto const alphas = _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, 0xFF), 0xFF); // NOLINT(*-magic-numbers)
+  auto const factors = _mm_or_si128(_mm_andnot_si128(alpha_words, alphas), keep_alpha);
+
+  // Alpha times 255 comes out as alpha again.
+  auto const product = _mm_add_epi16(_mm_mullo_epi16(words, factors), _mm_set1_epi16(128)); // NOLINT(*-magic-numbers)
+  return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+auto premultiply_alpha_sse2(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+  auto const zero = _mm_setzero_si128();
+
+  auto i = std::size_t(0);
+
+  for(; i + 4 <= count; i += 4) {
+    auto* const pixels = reinterpret_cast<__m128i*>(rgba + i * 4); // NOLINT
+    auto const bytes = _mm_loadu_si128(pixels);
+
+    auto const low = premultiply_words(_mm_unpacklo_epi8(bytes, zero));
+    auto const high = premultiply_words(_mm_unpackhi_epi8(bytes, zero));
+
+    _mm_storeu_si128(pixels, _mm_packus_epi16(low, high));
+  }
+
+  premultiply_alpha_from(rgba, i, count);
+}
+
+// No byte shuffle in SSE2, each channel is shifted into place on its own.
+auto swizzle_sse2(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+  auto const low_byte = _mm_set1_epi32(0xFF); // NOLINT(*-magic-numbers)
+
+  __m128i from_shifts[4]; // NOLINT(*-avoid-c-arrays)
+  __m128i to_shifts[4]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto c = 0; c < 4; ++c) {
+    from_shifts[c] = _mm_cvtsi32_si128((order.from[c] & 3) * 8);
+    to_shifts[c] = _mm_cvtsi32_si128(c * 8);
+  }
+
+  auto i = std::size_t(0);
+
+  for(; i + 4 <= count; i += 4) {
+    auto const pixels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i * 4)); // NOLINT
+
+    auto swizzled = _mm_setzero_si128();
+
+    for(auto c = 0; c < 4; ++c) {
+      auto const channel = _mm_and_si128(_mm_srl_epi32(pixels, from_shifts[c]), low_byte);
+      swizzled = _mm_or_si128(swizzled, _mm_sll_epi32(channel, to_shifts[c]));
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), swizzled); // NOLINT
+  }
+
+  swizzle_from(source, i, count, order, destination);
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+auto expand_rgb_avx(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  auto const alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000U)); // NOLINT(*-magic-numbers)
+
+  // 4 pixels, 12 bytes, to the bottom of each 16 byte lane, then spread to 4 bytes a pixel with a zero where alpha goes.
+  auto const to_lanes = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+  auto const spread = _mm256_setr_epi8(
+    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+  );
+
+  auto i = std::size_t(0);
+
+  // 32 bytes are loaded for 24.
+  for(; i + 11 <= count; i += 8) {
+    auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(rgb + i * 3)); // NOLINT
+    auto const pixels = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(bytes, to_lanes), spread);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), _mm256_or_si256(pixels, alpha)); // NOLINT
+  }
+
+  expand_rgb_sse2(rgb + i * 3, count - i, rgba + i * 4);
+}
+
+auto premultiply_words(__m256i const words) -> __m256i
+{
+  auto const alpha_words = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+  auto const keep_alpha = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255); // NOLINT(*-magic-numbers)
+
+  auto const alphas = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(words, 0xFF), 0xFF); // NOLINT(*-magic-numbers)
+  auto const factors = _mm256_or_si256(_mm256_andnot_si256(alpha_words, alphas), keep_alpha);
+
+  auto const product = _mm256_add_epi16(_mm256_mullo_epi16(words, factors), _mm256_set1_epi16(128)); // NOLINT(*-magic-numbers)
+  return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+}
+
+auto premultiply_alpha_avx(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+  auto const zero = _mm256_setzero_si256();
+
+  auto i = std::size_t(0);
+
+  // Unpacking and packing stay within 16 byte lanes, so the pixels come back where they were.
+  for(; i + 8 <= count; i += 8) {
+    auto* const pixels = reinterpret_cast<__m256i*>(rgba + i * 4); // NOLINT
+    auto const bytes = _mm256_loadu_si256(pixels);
+
+    auto const low = premultiply_words(_mm256_unpacklo_epi8(bytes, zero));
+    auto const high = premultiply_words(_mm256_unpackhi_epi8(bytes, zero));
+
+    _mm256_storeu_si256(pixels, _mm256_packus_epi16(low, high));
+  }
+
+  premultiply_alpha_sse2(rgba + i * 4, count - i);
+}
+
+auto swizzle_avx(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+  alignas(32) std::int8_t indices[32]; // NOLINT(*-avoid-c-arrays)
+
+  for(auto byte = 0; byte < 32; ++byte) {
+    indices[byte] = static_cast<std::int8_t>((byte & ~3) % 16 + (order.from[byte & 3] & 3));
+  }
+
+  auto const shuffle = _mm256_load_si256(reinterpret_cast<__m256i const*>(indices)); // NOLINT
+
+  auto i = std::size_t(0);
+
+  for(; i + 8 <= count; i += 8) {
+    auto const pixels = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i * 4)); // NOLINT
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_shuffle_epi8(pixels, shuffle)); // NOLINT
+  }
+
+  swizzle_sse2(source + i * 4, count - i, order, destination + i * 4);
+}
+
+#endif
+
+} // namespace
@@ -0,0 +1,105 @@
+#include "trujkont/pixels/pixel_kernel_impl.hpp"
+
+namespace pixel_kernels
+{
+
+auto expand_rgb_scalar(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  expand_rgb_from(rgb, 0, count, rgba);
+}
+
+auto expand_rgb_sse(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  expand_rgb_sse2(rgb, count, rgba);
+#else
+  expand_rgb_from(rgb, 0, count, rgba);
+#endif
+}
+
+auto premultiply_alpha_scalar(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+  premultiply_alpha_from(rgba, 0, count);
+}
+
+auto premultiply_alpha_sse(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  premultiply_alpha_sse2(rgba, count);
+#else
+  premultiply_alpha_from(rgba, 0, count);
+#endif
+}
+
+auto swizzle_scalar(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+  swizzle_from(source, 0, count, order, destination);
+}
+
+auto swizzle_sse(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  swizzle_sse2(source, count, order, destination);
+#else
+  swizzle_from(source, 0, count, order, destination);
+#endif
+}
+
+auto srgb_to_linear_scalar(std::uint8_t const* const rgba, std::size_t const count, float const* const decode_table, float* const linear) -> void
+{
+  srgb_to_linear<ScalarFloats>(rgba, count, decode_table, linear);
+}
+
+auto srgb_to_linear_sse(std::uint8_t const* const rgba, std::size_t const count, float const* const decode_table, float* const linear) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  srgb_to_linear<SseFloats>(rgba, count, decode_table, linear);
+#else
+  srgb_to_linear<ScalarFloats>(rgba, count, decode_table, linear);
+#endif
+}
+
+auto linear_to_srgb_scalar(float const* const linear, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  linear_to_srgb<ScalarFloats>(linear, count, rgba);
+}
+
+auto linear_to_srgb_sse(float const* const linear, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  linear_to_srgb<SseFloats>(linear, count, rgba);
+#else
+  linear_to_srgb<ScalarFloats>(linear, count, rgba);
+#endif
+}
+
+#if not defined(TRUJKONT_AVX2_KERNELS)
+
+auto expand_rgb_avx2(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  expand_rgb_sse(rgb, count, rgba);
+}
+
+auto premultiply_alpha_avx2(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+  premultiply_alpha_sse(rgba, count);
+}
+
+auto swizzle_avx2(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+  swizzle_sse(source, count, order, destination);
+}
+
+auto srgb_to_linear_avx2(std::uint8_t const* const rgba, std::size_t const count, float const* const decode_table, float* const linear) -> void
+{
+  srgb_to_linear_sse(rgba, count, decode_table, linear);
+}
+
+auto linear_to_srgb_avx2(float const* const linear, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  linear_to_srgb_sse(linear, count, rgba);
+}
+
+#endif
+
+} // namespace pixel_kernels
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Where each of the 4 output channels is read from in the input pixel, e.g. { 2, 1, 0, 3 } turns BGRA into RGBA.
+// Kept free of standard library types for the same reason `TransformArrays` is.
+struct ChannelOrder
+{
+  std::uint8_t from[4] = { 0, 1, 2, 3 }; // NOLINT(*-avoid-c-arrays)
+};
+
+// Each converts `count` pixels, 8 bit channels are tightly packed, float ones too, 4 per pixel.
+// `swizzle` and `premultiply_alpha` may work in place, the rest need separate buffers.
+namespace pixel_kernels
+{
+
+// Alpha is 255.
+auto expand_rgb_scalar(std::uint8_t const* rgb, std::size_t count, std::uint8_t* rgba) -> void;
+
+auto expand_rgb_sse(std::uint8_t const* rgb, std::size_t count, std::uint8_t* rgba) -> void;
+
+auto expand_rgb_avx2(std::uint8_t const* rgb, std::size_t count, std::uint8_t* rgba) -> void;
+
+// Color times alpha over 255, rounded to nearest.
+auto premultiply_alpha_scalar(std::uint8_t* rgba, std::size_t count) -> void;
+
+auto premultiply_alpha_sse(std::uint8_t* rgba, std::size_t count) -> void;
+
+auto premultiply_alpha_avx2(std::uint8_t* rgba, std::size_t count) -> void;
+
+auto swizzle_scalar(std::uint8_t const* source, std::size_t count, ChannelOrder const& order, std::uint8_t* destination) -> void;
+
+auto swizzle_sse(std::uint8_t const* source, std::size_t count, ChannelOrder const& order, std::uint8_t* destination) -> void;
+
+auto swizzle_avx2(std::uint8_t const* source, std::size_t count, ChannelOrder const& order, std::uint8_t* destination) -> void;
+
+// Color through `decode_table`, 256 linear values in [0, 1] one per sRGB byte, alpha is linear already and only scaled.
+auto srgb_to_linear_scalar(std::uint8_t const* rgba, std::size_t count, float const* decode_table, float* linear) -> void;
+
+auto srgb_to_linear_sse(std::uint8_t const* rgba, std::size_t count, float const* decode_table, float* linear) -> void;
+
+auto srgb_to_linear_avx2(std::uint8_t const* rgba, std::size_t count, float const* decode_table, float* linear) -> void;
+
+// Clamped to [0, 1] and rounded, color within a hundredth of a byte step of the exact sRGB curve.
+auto linear_to_srgb_scalar(float const* linear, std::size_t count, std::uint8_t* rgba) -> void;
+
+auto linear_to_srgb_sse(float const* linear, std::size_t count, std::uint8_t* rgba) -> void;
+
+auto linear_to_srgb_avx2(float const* linear, std::size_t count, std::uint8_t* rgba) -> void;
+
+} // namespace pixel_kernels
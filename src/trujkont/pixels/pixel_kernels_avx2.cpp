@@ -0,0 +1,32 @@
+#include "trujkont/simd/simd_float_avx2.hpp"
+#include "trujkont/pixels/pixel_kernel_impl.hpp"
+
+namespace pixel_kernels
+{
+
+auto expand_rgb_avx2(std::uint8_t const* const rgb, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  expand_rgb_avx(rgb, count, rgba);
+}
+
+auto premultiply_alpha_avx2(std::uint8_t* const rgba, std::size_t const count) -> void
+{
+  premultiply_alpha_avx(rgba, count);
+}
+
+auto swizzle_avx2(std::uint8_t const* const source, std::size_t const count, ChannelOrder const& order, std::uint8_t* const destination) -> void
+{
+  swizzle_avx(source, count, order, destination);
+}
+
+auto srgb_to_linear_avx2(std::uint8_t const* const rgba, std::size_t const count, float const* const decode_table, float* const linear) -> void
+{
+  srgb_to_linear<Avx2Floats>(rgba, count, decode_table, linear);
+}
+
+auto linear_to_srgb_avx2(float const* const linear, std::size_t const count, std::uint8_t* const rgba) -> void
+{
+  linear_to_srgb<Avx2Floats>(linear, count, rgba);
+}
+
+} // namespace pixel_kernels
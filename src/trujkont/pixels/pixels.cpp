@@ -0,0 +1,116 @@
+#include <stdexcept>
+#include <cstdint>
+#include <array>
+#include <cmath>
+
+#include "trujkont/pixels/pixels.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr srgb_toe = 0.04045F;
+
+// The exact curve, looked up by the kernels: 256 inputs are cheaper to tabulate than any fit is to evaluate.
+auto srgb_decode_table() -> std::array<float, 256> const&
+{
+  auto static const table = [] {
+    auto values = std::array<float, 256>();
+
+    for(auto i = std::size_t(0); i < values.size(); ++i) {
+      auto const encoded = static_cast<float>(i) / 255.0F;
+      values[i] = encoded <= srgb_toe ? encoded / 12.92F : std::pow((encoded + 0.055F) / 1.055F, 2.4F); // NOLINT(*-magic-numbers)
+    }
+
+    return values;
+  }();
+
+  return table;
+}
+
+// Of pixels with `from_channels` into pixels with `to_channels`, whole ones on both sides.
+auto check_sizes(std::size_t const from_size, std::size_t const from_channels, std::size_t const to_size, std::size_t const to_channels) -> void
+{
+  if(from_size % from_channels != 0 or to_size != from_size / from_channels * to_channels) {
+    throw std::invalid_argument(fmt::format("Got {} values of {} channel pixels for {} of {} channel ones", from_size, from_channels, to_size, to_channels));
+  }
+}
+
+auto bytes(std::span<std::byte const> const pixels) -> std::uint8_t const*
+{
+  return reinterpret_cast<std::uint8_t const*>(pixels.data()); // NOLINT
+}
+
+auto bytes(std::span<std::byte> const pixels) -> std::uint8_t*
+{
+  return reinterpret_cast<std::uint8_t*>(pixels.data()); // NOLINT
+}
+
+} // namespace
+
+auto expand_rgb(std::span<std::byte const> const rgb, std::span<std::byte> const rgba, SimdLevel const level) -> void
+{
+  check_sizes(rgb.size(), 3, rgba.size(), 4);
+
+  auto const count = rgb.size() / 3;
+
+  switch(level) {
+    case SimdLevel::Scalar: pixel_kernels::expand_rgb_scalar(bytes(rgb), count, bytes(rgba)); return;
+    case SimdLevel::Sse: pixel_kernels::expand_rgb_sse(bytes(rgb), count, bytes(rgba)); return;
+    case SimdLevel::Avx2: pixel_kernels::expand_rgb_avx2(bytes(rgb), count, bytes(rgba)); return;
+  }
+}
+
+auto premultiply_alpha(std::span<std::byte> const rgba, SimdLevel const level) -> void
+{
+  check_sizes(rgba.size(), 4, rgba.size(), 4);
+
+  auto const count = rgba.size() / 4;
+
+  switch(level) {
+    case SimdLevel::Scalar: pixel_kernels::premultiply_alpha_scalar(bytes(rgba), count); return;
+    case SimdLevel::Sse: pixel_kernels::premultiply_alpha_sse(bytes(rgba), count); return;
+    case SimdLevel::Avx2: pixel_kernels::premultiply_alpha_avx2(bytes(rgba), count); return;
+  }
+}
+
+auto swizzle(std::span<std::byte const> const source, ChannelOrder const& order, std::span<std::byte> const destination, SimdLevel const level) -> void
+{
+  check_sizes(source.size(), 4, destination.size(), 4);
+
+  auto const count = source.size() / 4;
+
+  switch(level) {
+    case SimdLevel::Scalar: pixel_kernels::swizzle_scalar(bytes(source), count, order, bytes(destination)); return;
+    case SimdLevel::Sse: pixel_kernels::swizzle_sse(bytes(source), count, order, bytes(destination)); return;
+    case SimdLevel::Avx2: pixel_kernels::swizzle_avx2(bytes(source), count, order, bytes(destination)); return;
+  }
+}
+
+auto srgb_to_linear(std::span<std::byte const> const rgba, std::span<float> const linear, SimdLevel const level) -> void
+{
+  check_sizes(rgba.size(), 4, linear.size(), 4);
+
+  auto const count = rgba.size() / 4;
+  auto const* const table = srgb_decode_table().data();
+
+  switch(level) {
+    case SimdLevel::Scalar: pixel_kernels::srgb_to_linear_scalar(bytes(rgba), count, table, linear.data()); return;
+    case SimdLevel::Sse: pixel_kernels::srgb_to_linear_sse(bytes(rgba), count, table, linear.data()); return;
+    case SimdLevel::Avx2: pixel_kernels::srgb_to_linear_avx2(bytes(rgba), count, table, linear.data()); return;
+  }
+}
+
+auto linear_to_srgb(std::span<float const> const linear, std::span<std::byte> const rgba, SimdLevel const level) -> void
+{
+  check_sizes(linear.size(), 4, rgba.size(), 4);
+
+  auto const count = linear.size() / 4;
+
+  switch(level) {
+    case SimdLevel::Scalar: pixel_kernels::linear_to_srgb_scalar(linear.data(), count, bytes(rgba)); return;
+    case SimdLevel::Sse: pixel_kernels::linear_to_srgb_sse(linear.data(), count, bytes(rgba)); return;
+    case SimdLevel::Avx2: pixel_kernels::linear_to_srgb_avx2(linear.data(), count, bytes(rgba)); return;
+  }
+}
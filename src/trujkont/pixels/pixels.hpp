@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "trujkont/pixels/pixel_kernels.hpp"
+#include "trujkont/simd/cpu_features.hpp"
+
+// Conversions of decoded images into what GL takes as is, meant for the job that decoded them, so uploads never
+// make the driver pad, swizzle or convert on the thread owning the context.
+// 8 bit images are tightly packed, 3 or 4 bytes per pixel like `RgbaView`, linear ones 4 floats per pixel.
+// Each throws `std::invalid_argument` when the two sides don't hold the same number of pixels.
+
+// RGB to RGBA, opaque. GL's rows of 4 byte pixels are always aligned, where RGB ones rarely are.
+auto expand_rgb(std::span<std::byte const> rgb, std::span<std::byte> rgba, SimdLevel level = best_simd_level()) -> void;
+
+// For `GL_ONE, GL_ONE_MINUS_SRC_ALPHA` blending, which unlike straight alpha filters and mips without dark fringes.
+auto premultiply_alpha(std::span<std::byte> rgba, SimdLevel level = best_simd_level()) -> void;
+
+// `source` and `destination` may be the same pixels.
+auto swizzle(std::span<std::byte const> source, ChannelOrder const& order, std::span<std::byte> destination, SimdLevel level = best_simd_level()) -> void;
+
+// Color from sRGB to linear, alpha only to [0, 1].
+auto srgb_to_linear(std::span<std::byte const> rgba, std::span<float> linear, SimdLevel level = best_simd_level()) -> void;
+
+// Back again, clamped to [0, 1] and rounded.
+auto linear_to_srgb(std::span<float const> linear, std::span<std::byte> rgba, SimdLevel level = best_simd_level()) -> void;
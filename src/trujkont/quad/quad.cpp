@@ -1,47 +1,97 @@
+#include <utility>
+
 #include "trujkont/quad/quad.hpp"
 
+#include "trujkont/gl_state/gl_state.hpp"
+
 Quad::Quad()
 {
-  VAO = 0u;
   glGenVertexArrays(1, &VAO);
-
-  auto VBO = 0u;
   glGenBuffers(1, &VBO);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glGenBuffers(1, &EBO);
 
-  glBindVertexArray(VAO);
+  gl_state::bind_buffer(GL_ARRAY_BUFFER, VBO);
 
-  glBufferData(GL_ARRAY_BUFFER, Quad::vertices.size() * sizeof(float), Quad::vertices.data(), GL_STATIC_DRAW);
+  gl_state::bind_vertex_array(VAO);
 
-  glVertexAttribPointer(
-    0,
-    3,
-    GL_FLOAT,
-    GL_FALSE,
-    Quad::attrs_per_vertex * sizeof(float),
-    reinterpret_cast<void*>(0)
-  );
-  glEnableVertexAttribArray(0);
-
-  glVertexAttribPointer(
-    1,
-    2,
-    GL_FLOAT,
-    GL_FALSE,
-    Quad::attrs_per_vertex * sizeof(float),
-    reinterpret_cast<void*>(3 * sizeof(float))
-  );
-  glEnableVertexAttribArray(1);
+  QuadLayout::setup();
 
-  auto EBO = 0u;
-  glGenBuffers(1, &EBO);
+  gl_state::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(int), indices.data(), GL_STATIC_DRAW);
+  upload_vertices();
 }
 
-auto Quad::update() -> void
+Quad::~Quad()
 {
-  glBindVertexArray(VAO);
-  glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+  gpu_memory::release(allocation);
+
+  gl_state::forget_vertex_array(VAO);
+  gl_state::forget_buffer(VBO);
+  gl_state::forget_buffer(EBO);
+
+  glDeleteVertexArrays(1, &VAO);
+  glDeleteBuffers(1, &VBO);
+  glDeleteBuffers(1, &EBO);
+}
+
+auto Quad::draw_instanced(GLsizei const instances_count) -> void
+{
+  if(allocation == 0) upload_vertices();
+  gpu_memory::touch(allocation);
+
+  gl_state::bind_vertex_array(VAO);
+  glDrawElementsInstanced(GL_TRIANGLES, indices.size(), GL_UNSIGNED_SHORT, nullptr, instances_count);
+}
+
+auto Quad::vertex_array() const noexcept -> GLuint
+{
+  return VAO;
+}
+
+auto Quad::pack_vertices() -> std::array<QuadVertex, vertices_count>
+{
+  auto packed = std::array<QuadVertex, vertices_count>();
+
+  for(auto i = std::size_t(0); i < packed.size(); ++i) {
+    auto const* const vertex = vertices.data() + i * attrs_per_vertex;
+
+    packed[i] = QuadVertex {
+      .corner = Snorm16x3::pack(glm::vec3(vertex[0], vertex[1], vertex[2]) / half_extent),
+      .texture_coords = Half2::pack(glm::vec2(vertex[3], vertex[4])),
+    };
+  }
+
+  return packed;
+}
+
+auto Quad::upload_vertices() -> void
+{
+  // Through a target no vertex array captures, so this works the same whether or not one is bound.
+  auto const packed = pack_vertices();
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, VBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, sizeof(packed), packed.data(), GL_STATIC_DRAW);
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, EBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, sizeof(indices), indices.data(), GL_STATIC_DRAW);
+
+  allocation = gpu_memory::track(
+    gpu_memory::Category::Mesh,
+    sizeof(packed) + sizeof(indices),
+    "quad",
+    [this] {
+      evict_vertices();
+      return true;
+    }
+  );
+}
+
+auto Quad::evict_vertices() -> void
+{
+  for(auto const buffer : { VBO, EBO }) {
+    gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+  }
+
+  gpu_memory::release(std::exchange(allocation, 0));
 }
@@ -1,19 +1,62 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
 #include <array>
 
 #include "glad/glad.h"
 
+#include "trujkont/vertex_layout/vertex_layout.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+
+struct QuadVertex
+{
+  // In units of `Quad::half_extent`.
+  Snorm16x3 corner;
+  Half2 texture_coords;
+};
+
+using QuadLayout = VertexLayout<
+  QuadVertex,
+  VertexAttribute<0, Snorm16x3, offsetof(QuadVertex, corner)>,
+  VertexAttribute<1, Half2, offsetof(QuadVertex, texture_coords)>>;
+
+// Its vertices are evictable by `gpu_memory`, they are uploaded again by the next draw.
 class Quad
 {
 public:
   Quad();
 
-  auto update() -> void;
+  Quad(Quad const&) = delete;
+  Quad(Quad&&) = delete;
+  auto operator=(Quad const&) -> Quad& = delete;
+  auto operator=(Quad&&) -> Quad& = delete;
+
+  ~Quad();
+
+  auto draw_instanced(GLsizei instances_count) -> void;
+
+  // For adding per instance attributes (from location `first_free_attr_location` on) to the quad's vertices.
+  [[nodiscard]] auto vertex_array() const noexcept -> GLuint;
+
+  auto inline static constexpr first_free_attr_location = QuadLayout::first_free_location;
+
+  // Of the unit quad, which shaders multiply the stored corners by.
+  auto inline static constexpr half_extent = 0.5F;
 
 private:
-  GLuint VAO;
+  auto upload_vertices() -> void;
+
+  // Only the buffers' stores are freed, the vertex array keeps pointing at the same buffers for when they're uploaded again.
+  auto evict_vertices() -> void;
+
+  GLuint VAO = 0;
+  GLuint VBO = 0;
+  GLuint EBO = 0;
 
+  gpu_memory::AllocationId allocation = 0;
+
+  // Position and texture coordinates, packed into `QuadVertex`es when uploaded.
   auto inline static constexpr attrs_per_vertex = 5;
 
   // clang-format off
@@ -24,9 +67,13 @@ private:
     -0.5f,  0.5f, 0.0f, 0.0f, 1.0f
   };
 
-  inline static auto constexpr indices = std::array {
+  inline static auto constexpr indices = std::array<std::uint16_t, 6> {
     0, 1, 3,
     1, 2, 3
   };
   // clang-format on
+
+  auto inline static constexpr vertices_count = vertices.size() / attrs_per_vertex;
+
+  [[nodiscard]] auto static pack_vertices() -> std::array<QuadVertex, vertices_count>;
 };
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <limits>
+#include <vector>
+#include <span>
+
+// Handle to an entity of a `Scene`. The index slot is reused once the entity is destroyed, the generation tells the
+// old handles apart from the new entity, so stale handles never alias whatever got created in their place.
+struct EntityId
+{
+  std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+  std::uint32_t generation = 0;
+
+  auto operator==(EntityId const&) const -> bool = default;
+};
+
+// Sparse set of one component type: the values of every entity that has one, densely packed in no particular order
+// for iteration, plus an entity index -> dense position table for O(1) lookups, insertions and removals
+// (removal moves the last value into the hole).
+template<typename T>
+class ComponentSet
+{
+public:
+  // Replaces the value if `entity` already has one.
+  auto add(EntityId const entity, T value) -> T&
+  {
+    if(auto* const existing = get(entity)) return *existing = std::move(value);
+
+    if(entity.index >= sparse.size()) sparse.resize(entity.index + 1, absent);
+
+    sparse[entity.index] = static_cast<std::uint32_t>(dense_values.size());
+    dense_entities.push_back(entity);
+
+    return dense_values.emplace_back(std::move(value));
+  }
+
+  auto remove(EntityId const entity) -> void
+  {
+    if(not contains(entity)) return;
+
+    auto const position = sparse[entity.index];
+    auto const last = dense_values.size() - 1;
+
+    if(position != last) {
+      dense_values[position] = std::move(dense_values[last]);
+      dense_entities[position] = dense_entities[last];
+      sparse[dense_entities[position].index] = position;
+    }
+
+    dense_values.pop_back();
+    dense_entities.pop_back();
+    sparse[entity.index] = absent;
+  }
+
+  [[nodiscard]] auto contains(EntityId const entity) const noexcept -> bool
+  {
+    return entity.index < sparse.size() and sparse[entity.index] != absent and dense_entities[sparse[entity.index]] == entity;
+  }
+
+  [[nodiscard]] auto get(EntityId const entity) noexcept -> T*
+  {
+    return contains(entity) ? &dense_values[sparse[entity.index]] : nullptr;
+  }
+
+  [[nodiscard]] auto get(EntityId const entity) const noexcept -> T const*
+  {
+    return contains(entity) ? &dense_values[sparse[entity.index]] : nullptr;
+  }
+
+  // `values()[i]` belongs to `entities()[i]`.
+  [[nodiscard]] auto values() noexcept -> std::span<T> { return dense_values; }
+
+  [[nodiscard]] auto values() const noexcept -> std::span<T const> { return dense_values; }
+
+  [[nodiscard]] auto entities() const noexcept -> std::span<EntityId const> { return dense_entities; }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return dense_values.size(); }
+
+private:
+  auto inline static constexpr absent = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<std::uint32_t> sparse;
+  std::vector<EntityId> dense_entities;
+  std::vector<T> dense_values;
+};
@@ -0,0 +1,124 @@
+#include <numbers>
+#include <cmath>
+
+#include "trujkont/scene/scene.hpp"
+
+#include "trujkont/culling/culling.hpp"
+
+auto MeshInstances::size() const noexcept -> std::size_t
+{
+  return entities.size();
+}
+
+auto Scene::create() -> EntityId
+{
+  if(free_slots.empty()) {
+    slots.push_back(Slot { .generation = 0, .alive = true, .instance = tl::nullopt });
+    return EntityId { .index = static_cast<std::uint32_t>(slots.size() - 1), .generation = 0 };
+  }
+
+  auto const index = free_slots.back();
+  free_slots.pop_back();
+
+  slots[index].alive = true;
+
+  return EntityId { .index = index, .generation = slots[index].generation };
+}
+
+auto Scene::destroy(EntityId const entity) -> void
+{
+  if(not alive(entity)) return;
+
+  remove_instance(entity);
+  materials.remove(entity);
+  billboards.remove(entity);
+
+  auto& slot = slots[entity.index];
+  slot.alive = false;
+  ++slot.generation;
+
+  free_slots.push_back(entity.index);
+}
+
+auto Scene::alive(EntityId const entity) const noexcept -> bool
+{
+  return entity.index < slots.size() and slots[entity.index].alive and slots[entity.index].generation == entity.generation;
+}
+
+auto Scene::add_instance(EntityId const entity, MeshId const mesh, Instance const& instance) -> void
+{
+  if(not alive(entity)) return;
+
+  remove_instance(entity);
+
+  auto& table = instances(mesh);
+
+  table.entities.push_back(entity);
+  table.transforms.push(instance.position, instance.rotation_axis, instance.angle, instance.scale);
+  table.spin_speeds.push_back(instance.spin_speed);
+  table.bounds.emplace_back();
+
+  slots[entity.index].instance = InstanceRow { .mesh = mesh, .row = table.size() - 1 };
+}
+
+auto Scene::remove_instance(EntityId const entity) -> void
+{
+  auto const location = find_instance(entity);
+  if(not location) return;
+
+  auto& table = instances(location->mesh);
+  auto const row = location->row;
+
+  table.transforms.swap_remove(row);
+
+  table.spin_speeds[row] = table.spin_speeds.back();
+  table.spin_speeds.pop_back();
+
+  table.bounds[row] = table.bounds.back();
+  table.bounds.pop_back();
+
+  table.entities[row] = table.entities.back();
+  table.entities.pop_back();
+
+  if(row < table.size()) slots[table.entities[row].index].instance->row = row;
+
+  slots[entity.index].instance = tl::nullopt;
+}
+
+auto Scene::find_instance(EntityId const entity) const noexcept -> tl::optional<InstanceRow>
+{
+  if(not alive(entity)) return tl::nullopt;
+
+  return slots[entity.index].instance;
+}
+
+auto Scene::instances(MeshId const mesh) noexcept -> MeshInstances&
+{
+  return tables[static_cast<std::size_t>(mesh)];
+}
+
+auto Scene::instances(MeshId const mesh) const noexcept -> MeshInstances const&
+{
+  return tables[static_cast<std::size_t>(mesh)];
+}
+
+auto Scene::entities_count() const noexcept -> std::size_t
+{
+  return slots.size() - free_slots.size();
+}
+
+auto spin_instances(MeshInstances& instances, float const seconds) -> void
+{
+  auto constexpr full_turn = 2 * std::numbers::pi_v<float>;
+
+  auto& angles = instances.transforms.angle;
+
+  for(auto i = std::size_t(0); i < instances.size(); ++i) {
+    angles[i] = std::fmod(angles[i] + instances.spin_speeds[i] * seconds, full_turn);
+  }
+}
+
+auto update_bounds(MeshInstances& instances, float const mesh_radius) -> void
+{
+  sphere_bounds(instances.transforms, mesh_radius, instances.bounds);
+}
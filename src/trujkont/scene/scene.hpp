@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include <tl/optional.hpp>
+
+#include "trujkont/billboard/billboard_sprite.hpp"
+#include "trujkont/transform/transform_store.hpp"
+#include "trujkont/scene/component_set.hpp"
+#include "trujkont/geometry/geometry.hpp"
+#include "trujkont/texture/texture.hpp"
+
+enum class MeshId : std::uint8_t
+{
+  Cube,
+
+  Count
+};
+
+struct Material
+{
+  TextureSlot texture = 0;
+};
+
+struct Instance
+{
+  glm::vec3 position = glm::vec3(0.);
+  glm::vec3 rotation_axis = glm::vec3(0., 1., 0.);
+  float angle = 0.0F;
+  glm::vec3 scale = glm::vec3(1.);
+
+  // Radians per second around `rotation_axis`.
+  float spin_speed = 0.0F;
+};
+
+// Every entity drawn with one mesh: one row per entity and one array per component, rows in no particular order.
+// This is what the per frame systems (spinning, bounds, culling, building instance data) stream through.
+struct MeshInstances
+{
+  std::vector<EntityId> entities;
+
+  TransformStore transforms;
+  std::vector<float> spin_speeds;
+
+  // World space, as of the last `update_bounds`.
+  std::vector<Aabb> bounds;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+};
+
+// Entities and their components. Transforms live in per mesh tables (`MeshInstances`, an entity's mesh decides which
+// table its row is in), everything else in sparse sets. Adding and removing anything is O(1); removing a row moves the
+// table's last row into its place, so row numbers (and anything built over them, e.g. a `Bvh`) change on removal.
+class Scene
+{
+public:
+  [[nodiscard]] auto create() -> EntityId;
+
+  // Also removes all of the entity's components, stale handles are ignored.
+  auto destroy(EntityId entity) -> void;
+
+  [[nodiscard]] auto alive(EntityId entity) const noexcept -> bool;
+
+  // Gives `entity` a transform and draws it as an instance of `mesh`, replacing any instance it already was.
+  auto add_instance(EntityId entity, MeshId mesh, Instance const& instance) -> void;
+
+  auto remove_instance(EntityId entity) -> void;
+
+  struct InstanceRow
+  {
+    MeshId mesh = MeshId::Cube;
+    std::size_t row = 0;
+  };
+
+  [[nodiscard]] auto find_instance(EntityId entity) const noexcept -> tl::optional<InstanceRow>;
+
+  [[nodiscard]] auto instances(MeshId mesh) noexcept -> MeshInstances&;
+
+  [[nodiscard]] auto instances(MeshId mesh) const noexcept -> MeshInstances const&;
+
+  [[nodiscard]] auto entities_count() const noexcept -> std::size_t;
+
+  ComponentSet<Material> materials;
+  ComponentSet<BillboardSprite> billboards;
+
+private:
+  struct Slot
+  {
+    std::uint32_t generation = 0;
+    bool alive = false;
+
+    // Where the entity's instance row is, if it has one.
+    tl::optional<InstanceRow> instance;
+  };
+
+  std::vector<Slot> slots;
+  std::vector<std::uint32_t> free_slots;
+
+  std::array<MeshInstances, static_cast<std::size_t>(MeshId::Count)> tables;
+};
+
+// Advances the angle of every spinning instance by `seconds`.
+auto spin_instances(MeshInstances& instances, float seconds) -> void;
+
+// Recomputes the world space boxes around every instance's bounding sphere, `mesh_radius` being the mesh's own.
+auto update_bounds(MeshInstances& instances, float mesh_radius) -> void;
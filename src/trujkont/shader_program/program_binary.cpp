@@ -0,0 +1,193 @@
+#include <system_error>
+#include <fstream>
+#include <atomic>
+#include <vector>
+#include <array>
+
+#include "trujkont/shader_program/program_binary.hpp"
+
+#include "trujkont/hash/hash.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto constexpr file_magic = std::array { 'T', 'R', 'J', 'K', 'P', 'R', 'O', 'G' };
+auto constexpr file_version = std::uint32_t(1);
+
+struct FileHeader
+{
+  std::array<char, 8> magic = file_magic;
+  std::uint32_t version = file_version;
+  std::uint32_t binary_format = 0;
+  std::uint64_t driver_program_key = 0;
+  std::uint64_t binary_size = 0;
+};
+
+static_assert(sizeof(FileHeader) == 32);
+
+auto directory = std::filesystem::path();
+
+// Folded into every key, so binaries from one driver are never offered to another one.
+auto driver_key = std::uint64_t(0);
+
+auto programs_loaded = std::atomic<std::uint64_t>(0);
+auto programs_rejected = std::atomic<std::uint64_t>(0);
+auto programs_stored = std::atomic<std::uint64_t>(0);
+
+auto gl_string(GLenum const name) -> std::string_view
+{
+  auto const* const string = reinterpret_cast<char const*>(glGetString(name)); // NOLINT
+
+  return string ? std::string_view(string) : std::string_view();
+}
+
+auto driver_program_key(std::uint64_t const program_key) -> std::uint64_t
+{
+  return hash::fnv1a64(program_key, driver_key);
+}
+
+auto binary_path(std::uint64_t const key) -> std::filesystem::path
+{
+  return directory / fmt::format("{:016x}.bin", key);
+}
+
+} // namespace
+
+namespace program_binary
+{
+
+auto enable(std::filesystem::path cache_directory) -> bool
+{
+  if(not GLAD_GL_ARB_get_program_binary) return false;
+
+  auto formats_count = GLint(0);
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats_count);
+  if(formats_count == 0) return false;
+
+  auto error = std::error_code();
+  std::filesystem::create_directories(cache_directory, error);
+  if(error) return false;
+
+  directory = std::move(cache_directory);
+
+  driver_key = hash::fnv1a64_offset;
+  for(auto const name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+    auto const string = gl_string(name);
+
+    driver_key = hash::fnv1a64(static_cast<std::uint64_t>(string.size()), driver_key);
+    driver_key = hash::fnv1a64(string, driver_key);
+  }
+
+  return true;
+}
+
+auto enabled() -> bool
+{
+  return not directory.empty();
+}
+
+auto load(std::uint64_t const program_key) -> tl::optional<ShaderProgram>
+{
+  if(not enabled()) return tl::nullopt;
+
+  auto const key = driver_program_key(program_key);
+  auto const path = binary_path(key);
+
+  auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+  if(not file) return tl::nullopt;
+
+  auto const file_size = static_cast<std::uint64_t>(file.tellg());
+  file.seekg(0);
+
+  auto header = FileHeader();
+  file.read(reinterpret_cast<char*>(&header), sizeof(header)); // NOLINT
+
+  // The binary is all that follows the header, a size claiming anything else is corrupt and never gets allocated.
+  auto binary = std::vector<std::byte>();
+  auto const header_valid = file and header.magic == file_magic and header.version == file_version and header.driver_program_key == key
+    and header.binary_size == file_size - sizeof(header);
+
+  if(header_valid) {
+    binary.resize(header.binary_size);
+    file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(binary.size())); // NOLINT
+  }
+
+  file.close();
+
+  if(header_valid and file) {
+    auto program = ShaderProgram(header.binary_format, binary);
+
+    if(program.param<ProgramAttr::LinkStatus>() == GL_TRUE) {
+      programs_loaded.fetch_add(1, std::memory_order_relaxed);
+      return program;
+    }
+
+    gl_state::forget_program(program.id);
+    glDeleteProgram(program.id);
+  }
+
+  // Truncated, corrupt, from another version of this format or refused by the driver, it's of no use anymore either way.
+  programs_rejected.fetch_add(1, std::memory_order_relaxed);
+
+  auto error = std::error_code();
+  std::filesystem::remove(path, error);
+
+  return tl::nullopt;
+}
+
+auto store(std::uint64_t const program_key, ShaderProgram const& program) -> void
+{
+  if(not enabled()) return;
+
+  auto header = FileHeader { .driver_program_key = driver_program_key(program_key) };
+
+  auto const binary_length = program.param<ProgramAttr::BinaryLength>();
+  if(binary_length == 0) return;
+
+  auto binary = std::vector<std::byte>(binary_length);
+  auto written = GLsizei(0);
+  glGetProgramBinary(program.id, static_cast<GLsizei>(binary.size()), &written, &header.binary_format, binary.data());
+  if(written == 0) return;
+
+  header.binary_size = static_cast<std::uint64_t>(written);
+
+  // Written next to the final file and renamed over it, so a crash midway never leaves a truncated binary behind.
+  auto const path = binary_path(header.driver_program_key);
+  auto temporary_path = path;
+  temporary_path += ".tmp";
+
+  {
+    auto file = std::ofstream(temporary_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header)); // NOLINT
+    file.write(reinterpret_cast<char const*>(binary.data()), written); // NOLINT
+
+    if(not file) return;
+  }
+
+  auto error = std::error_code();
+  std::filesystem::rename(temporary_path, path, error);
+
+  if(error) {
+    std::filesystem::remove(temporary_path, error);
+    return;
+  }
+
+  programs_stored.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto report() -> std::string
+{
+  if(not enabled()) return "binaries: disabled\n";
+
+  return fmt::format(
+    "binaries: {:>6} loaded, {:>6} rejected, {:>6} stored ({})\n",
+    programs_loaded.load(std::memory_order_relaxed),
+    programs_rejected.load(std::memory_order_relaxed),
+    programs_stored.load(std::memory_order_relaxed),
+    directory.c_str()
+  );
+}
+
+} // namespace program_binary
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+#include <string>
+
+#include <tl/optional.hpp>
+
+#include "trujkont/shader_program/shader_program.hpp"
+
+// Linked programs saved to disk with `glGetProgramBinary`, so later launches can skip compiling them.
+// A binary is only good for the exact driver that produced it, so the files are keyed by the program's key
+// together with the GL vendor, renderer and version strings. Everything here is best effort,
+// any I/O error or rejected binary just means the program gets compiled from source again.
+// Like `program_cache`, must only be used from the thread owning the GL context.
+namespace program_binary
+{
+
+// Does nothing (and returns false) when the driver offers no binary formats.
+auto enable(std::filesystem::path directory) -> bool;
+
+[[nodiscard]] auto enabled() -> bool;
+
+// Empty when nothing was saved for `program_key`, or the driver refused the saved binary (the file is removed then).
+[[nodiscard]] auto load(std::uint64_t program_key) -> tl::optional<ShaderProgram>;
+
+auto store(std::uint64_t program_key, ShaderProgram const& program) -> void;
+
+[[nodiscard]] auto report() -> std::string;
+
+} // namespace program_binary
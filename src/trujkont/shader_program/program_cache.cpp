@@ -0,0 +1,460 @@
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <atomic>
+#include <vector>
+
+#include "trujkont/shader_program/program_cache.hpp"
+
+#include "trujkont/shader_program/program_binary.hpp"
+#include "trujkont/asset_pack/asset_pack.hpp"
+#include "trujkont/hash/hash.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+// Stages that were handed to the driver, with nothing asked about them yet. Asking is what makes it wait.
+struct Submitted
+{
+  std::vector<Shader> shaders;
+  GLuint program = 0;
+};
+
+struct PendingProgram
+{
+  std::uint64_t key = 0;
+  Submitted submitted;
+
+  // Everyone who asked for this program while it was compiling.
+  std::vector<std::weak_ptr<program_cache::AsyncProgram>> waiting;
+
+  // Only asked for by `reload`: an edit in progress, not worth saving, and what it replaces is let go.
+  bool reload = false;
+};
+
+// A stage's source, either straight from the pages of the mounted asset pack (which stay mapped for good)
+// or read from a loose file.
+struct SourceText
+{
+  std::string_view mapped;
+  std::string owned;
+
+  [[nodiscard]] auto view() const -> std::string_view { return mapped.data() ? mapped : std::string_view(owned); }
+};
+
+// Programs loaded from files, along with what's needed to rebuild them when one of the files changes.
+struct WatchedProgram
+{
+  std::weak_ptr<program_cache::AsyncProgram> program;
+
+  std::vector<program_cache::StageFile> files;
+  std::vector<SourceText> sources;
+  std::vector<std::string> defines;
+};
+
+auto programs = std::unordered_map<std::uint64_t, program_cache::ProgramHandle>();
+auto pending_programs = std::vector<PendingProgram>();
+auto watched_programs = std::vector<WatchedProgram>();
+
+auto programs_built = std::atomic<std::uint64_t>(0);
+auto programs_reused = std::atomic<std::uint64_t>(0);
+auto programs_pending = std::atomic<std::size_t>(0);
+auto programs_reloaded = std::atomic<std::uint64_t>(0);
+auto programs_released = std::atomic<std::uint64_t>(0);
+
+auto stage_name(ShaderType const type) -> std::string_view
+{
+  switch(type) {
+    case ShaderType::Compute: return "Compute";
+    case ShaderType::Vertex: return "Vertex";
+    case ShaderType::TessControl: return "Tessellation control";
+    case ShaderType::TessEvaluation: return "Tessellation evaluation";
+    case ShaderType::Geometry: return "Geometry";
+    case ShaderType::Fragment: return "Fragment";
+  }
+
+  return "Unknown";
+}
+
+auto parallel_compile_supported() -> bool
+{
+  return GLAD_GL_KHR_parallel_shader_compile or GLAD_GL_ARB_parallel_shader_compile;
+}
+
+// The defines have to come after `#version`, which must be the first thing in the source.
+auto with_defines(std::string_view const source, program_cache::Defines const defines) -> std::string
+{
+  auto const version_start = source.find("#version");
+  auto const version_end = version_start == std::string_view::npos ? std::string_view::npos : source.find('\n', version_start);
+  auto const split = version_end == std::string_view::npos ? 0 : version_end + 1;
+
+  auto result = std::string(source.substr(0, split));
+  for(auto const define : defines) result += fmt::format("#define {}\n", define);
+
+  // Keeps the line numbers in the compile log pointing at the actual file.
+  if(not defines.empty()) result += fmt::format("#line {}\n", std::count(source.begin(), source.begin() + split, '\n') + 1);
+
+  result += source.substr(split);
+
+  return result;
+}
+
+auto submit(std::span<program_cache::StageSource const> const stages, program_cache::Defines const defines) -> Submitted
+{
+  // Drivers only spread compiles over their own threads once asked to.
+  auto static threads_requested = false;
+  if(not threads_requested) {
+    if(GLAD_GL_KHR_parallel_shader_compile) glMaxShaderCompilerThreadsKHR(0xFFFFFFFFU);
+    else if(GLAD_GL_ARB_parallel_shader_compile) glMaxShaderCompilerThreadsARB(0xFFFFFFFFU);
+
+    threads_requested = true;
+  }
+
+  auto submitted = Submitted { .shaders = {}, .program = glCreateProgram() };
+  submitted.shaders.reserve(stages.size());
+
+  for(auto const& [type, source] : stages) {
+    auto const defined_source = defines.empty() ? std::string() : with_defines(source, defines);
+    submitted.shaders.emplace_back(type, defines.empty() ? source : std::string_view(defined_source));
+  }
+
+  // Has to be set before linking, for `glGetProgramBinary` to be able to return anything afterwards.
+  if(GLAD_GL_ARB_get_program_binary) glProgramParameteri(submitted.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+  // Linking right away is fine even if a stage fails to compile, the link then fails too and the logs tell why.
+  for(auto const& shader : submitted.shaders) glAttachShader(submitted.program, shader.id);
+  glLinkProgram(submitted.program);
+
+  return submitted;
+}
+
+// Never blocks when parallel compiles are supported, otherwise there is no way to tell, so everything counts as done.
+auto completed(Submitted const& submitted) -> bool
+{
+  if(not parallel_compile_supported()) return true;
+
+  auto status = GLint(0);
+  glGetProgramiv(submitted.program, GL_COMPLETION_STATUS_KHR, &status);
+
+  return status == GL_TRUE;
+}
+
+// Waits for the driver if it's not done yet.
+auto finish(Submitted&& submitted) -> tl::expected<ShaderProgram, std::string>
+{
+  auto link_status = GLint(0);
+  glGetProgramiv(submitted.program, GL_LINK_STATUS, &link_status);
+
+  auto error = std::string();
+
+  if(link_status != GL_TRUE) {
+    for(auto const& shader : submitted.shaders) {
+      if(shader.param<ShaderAttr::CompileStatus>() == GL_TRUE) continue;
+
+      auto const type = static_cast<ShaderType>(shader.param<ShaderAttr::Type>());
+      error += fmt::format("{} shader compilation failed! Log:\n\n{}\n", stage_name(type), shader.log());
+    }
+
+    // Only worth reporting when the stages compiled, otherwise it just repeats their errors.
+    if(error.empty()) {
+      auto log_size = GLint(0);
+      glGetProgramiv(submitted.program, GL_INFO_LOG_LENGTH, &log_size);
+
+      auto log = std::string(static_cast<std::size_t>(log_size), '\0');
+      glGetProgramInfoLog(submitted.program, log_size, nullptr, log.data());
+
+      error = fmt::format("Shader program linking failed! Log:\n\n{}\n", log);
+    }
+  }
+
+  for(auto const& shader : submitted.shaders) {
+    glDetachShader(submitted.program, shader.id);
+    glDeleteShader(shader.id);
+  }
+
+  if(not error.empty()) {
+    gl_state::forget_program(submitted.program);
+    glDeleteProgram(submitted.program);
+
+    return tl::make_unexpected(std::move(error));
+  }
+
+  return ShaderProgram(ShaderProgram::AdoptLinked(), submitted.program);
+}
+
+auto remember(std::uint64_t const key, ShaderProgram&& program, bool const persist) -> program_cache::ProgramHandle
+{
+  programs_built.fetch_add(1, std::memory_order_relaxed);
+  if(persist) program_binary::store(key, program);
+
+  return programs.insert_or_assign(key, std::make_shared<ShaderProgram const>(std::move(program))).first->second;
+}
+
+// Handles never delete their programs. One a reload replaced is deleted here, once the cache holds its last handle;
+// anyone else still drawing with it keeps it cached until they're reloaded too.
+auto forget_superseded(program_cache::ProgramHandle superseded) -> void
+{
+  if(not superseded) return;
+
+  auto const it = std::ranges::find(programs, superseded, [](auto const& entry) { return entry.second; });
+  if(it == programs.end() or superseded.use_count() > 2) return;
+
+  programs.erase(it);
+  programs_released.fetch_add(1, std::memory_order_relaxed);
+
+  gl_state::forget_program(superseded->id);
+  glDeleteProgram(superseded->id);
+}
+
+// Already linked in this run or saved by an earlier one.
+auto find_linked(std::uint64_t const key) -> program_cache::ProgramHandle
+{
+  if(auto const it = programs.find(key); it != programs.end()) {
+    programs_reused.fetch_add(1, std::memory_order_relaxed);
+    return it->second;
+  }
+
+  if(auto program = program_binary::load(key)) {
+    return programs.emplace(key, std::make_shared<ShaderProgram const>(*std::move(program))).first->second;
+  }
+
+  return nullptr;
+}
+
+// Either the program is linked already and returned, or `waiting` gets it from a later `poll`.
+// Anything `waiting` was still waiting for is forgotten, so an older compile finishing late can never replace a newer one.
+auto request(
+  std::span<program_cache::StageSource const> const stages,
+  program_cache::Defines const defines,
+  std::shared_ptr<program_cache::AsyncProgram> const& waiting,
+  bool const reload
+) -> program_cache::ProgramHandle
+{
+  for(auto& pending : pending_programs) {
+    std::erase_if(pending.waiting, [&waiting](auto const& other) { return other.lock() == waiting; });
+  }
+
+  auto const key = program_cache::program_key(stages, defines);
+
+  if(auto program = find_linked(key)) return program;
+
+  // Asked for again before the first request finished, no need to compile it twice.
+  auto const same_program = std::ranges::find(pending_programs, key, &PendingProgram::key);
+  if(same_program != pending_programs.end()) {
+    same_program->waiting.push_back(waiting);
+    same_program->reload = same_program->reload and reload;
+    return nullptr;
+  }
+
+  pending_programs.push_back(PendingProgram { .key = key, .submitted = submit(stages, defines), .waiting = { waiting }, .reload = reload });
+  programs_pending.store(pending_programs.size(), std::memory_order_relaxed);
+
+  return nullptr;
+}
+
+auto read_sources(std::span<program_cache::StageFile const> const stages) -> tl::expected<std::vector<SourceText>, std::string>
+{
+  auto sources = std::vector<SourceText>();
+  sources.reserve(stages.size());
+
+  for(auto const& stage : stages) {
+    if(auto const packed = assets::find(stage.path)) {
+      auto const text = std::string_view(reinterpret_cast<char const*>(packed->data()), packed->size()); // NOLINT
+      sources.push_back(SourceText { .mapped = text, .owned = {} });
+      continue;
+    }
+
+    auto source = program_cache::read_shader_source(stage.path);
+    if(not source) return tl::make_unexpected(std::move(source.error()));
+
+    sources.push_back(SourceText { .mapped = {}, .owned = std::move(*source) });
+  }
+
+  return sources;
+}
+
+auto stage_sources(std::span<program_cache::StageFile const> const stages, std::span<SourceText const> const sources)
+{
+  auto result = std::vector<program_cache::StageSource>();
+  result.reserve(stages.size());
+
+  for(auto i = 0U; i < stages.size(); ++i) result.push_back({ stages[i].type, sources[i].view() });
+
+  return result;
+}
+
+} // namespace
+
+namespace program_cache
+{
+
+auto program_key(std::span<StageSource const> const stages, Defines const defines) -> std::uint64_t
+{
+  auto key = hash::fnv1a64_offset;
+
+  // Lengths go in too, so moving text between neighbouring pieces changes the key.
+  for(auto const& [type, source] : stages) {
+    key = hash::fnv1a64(static_cast<std::uint64_t>(type), key);
+    key = hash::fnv1a64(static_cast<std::uint64_t>(source.size()), key);
+    key = hash::fnv1a64(source, key);
+  }
+
+  for(auto const define : defines) {
+    key = hash::fnv1a64(static_cast<std::uint64_t>(define.size()), key);
+    key = hash::fnv1a64(define, key);
+  }
+
+  return key;
+}
+
+auto get(std::span<StageSource const> const stages, Defines const defines) -> tl::expected<ProgramHandle, std::string>
+{
+  auto const key = program_key(stages, defines);
+
+  if(auto program = find_linked(key)) return program;
+
+  return finish(submit(stages, defines)).map([key](ShaderProgram&& program) {
+    return remember(key, std::move(program), true);
+  });
+}
+
+auto load(std::span<StageFile const> const stages, Defines const defines) -> tl::expected<ProgramHandle, std::string>
+{
+  return read_sources(stages).and_then([&](std::vector<SourceText> const& sources) {
+    return get(stage_sources(stages, sources), defines);
+  });
+}
+
+auto get_async(std::span<StageSource const> const stages, Defines const defines, ProgramHandle fallback) -> AsyncProgramHandle
+{
+  auto async_program = std::make_shared<AsyncProgram>(std::move(fallback));
+
+  if(auto program = request(stages, defines, async_program, false)) async_program->swap_in(std::move(program));
+
+  return async_program;
+}
+
+auto load_async(std::span<StageFile const> const stages, Defines const defines, ProgramHandle fallback) -> tl::expected<AsyncProgramHandle, std::string>
+{
+  return read_sources(stages).map([&](std::vector<SourceText>&& sources) {
+    auto async_program = get_async(stage_sources(stages, sources), defines, std::move(fallback));
+
+    watched_programs.push_back(WatchedProgram {
+      .program = async_program,
+      .files = std::vector(stages.begin(), stages.end()),
+      .sources = std::move(sources),
+      .defines = std::vector<std::string>(defines.begin(), defines.end()),
+    });
+
+    return async_program;
+  });
+}
+
+auto reload(std::span<ChangedFile const> const changes) -> void
+{
+  if(changes.empty()) return;
+
+  std::erase_if(watched_programs, [](WatchedProgram const& watched) { return watched.program.expired(); });
+
+  for(auto& watched : watched_programs) {
+    auto changed = false;
+
+    for(auto const& change : changes) {
+      auto const path = change.path.lexically_normal();
+
+      for(auto i = 0U; i < watched.files.size(); ++i) {
+        if(watched.files[i].path.lexically_normal() != path) continue;
+
+        watched.sources[i] = SourceText { .mapped = {}, .owned = change.source };
+        changed = true;
+      }
+    }
+
+    if(not changed) continue;
+
+    programs_reloaded.fetch_add(1, std::memory_order_relaxed);
+
+    auto const defines = std::vector<std::string_view>(watched.defines.begin(), watched.defines.end());
+    auto const async_program = watched.program.lock();
+
+    if(auto program = request(stage_sources(watched.files, watched.sources), defines, async_program, true)) {
+      forget_superseded(async_program->swap_in(std::move(program)));
+    }
+  }
+}
+
+auto poll() -> void
+{
+  auto finished_one = false;
+
+  for(auto it = pending_programs.begin(); it != pending_programs.end();) {
+    if(finished_one and not parallel_compile_supported()) break;
+
+    if(not completed(it->submitted)) {
+      ++it;
+      continue;
+    }
+
+    finished_one = true;
+
+    auto program = finish(std::move(it->submitted)).map([key = it->key, persist = not it->reload](ShaderProgram&& linked) {
+      return remember(key, std::move(linked), persist);
+    });
+
+    if(not program) fmt::print(stderr, "{}", program.error());
+
+    for(auto const& waiting : it->waiting) {
+      auto const async_program = waiting.lock();
+      if(not async_program) continue;
+
+      if(not program) {
+        async_program->last_error = program.error();
+        continue;
+      }
+
+      auto previous = async_program->swap_in(*program);
+      if(it->reload) forget_superseded(std::move(previous));
+    }
+
+    it = pending_programs.erase(it);
+  }
+
+  programs_pending.store(pending_programs.size(), std::memory_order_relaxed);
+}
+
+auto pending() -> std::size_t
+{
+  return programs_pending.load(std::memory_order_relaxed);
+}
+
+auto read_shader_source(std::filesystem::path const& path) -> tl::expected<std::string, std::string>
+{
+  if(not std::filesystem::exists(path)) {
+    return tl::make_unexpected(fmt::format("Cannot find shader @ path: \"{}\"", path.c_str()));
+  }
+
+  auto file = std::ifstream(path.c_str());
+
+  return std::string(
+    std::istreambuf_iterator<char>(file),
+    {}
+  );
+}
+
+auto report() -> std::string
+{
+  return fmt::format(
+    "programs: {:>6} built, {:>6} reused, {:>6} reloaded, {:>6} released, {:>6} compiling{}\n{}",
+    programs_built.load(std::memory_order_relaxed),
+    programs_reused.load(std::memory_order_relaxed),
+    programs_reloaded.load(std::memory_order_relaxed),
+    programs_released.load(std::memory_order_relaxed),
+    programs_pending.load(std::memory_order_relaxed),
+    parallel_compile_supported() ? "" : " (no parallel compile)",
+    program_binary::report()
+  );
+}
+
+} // namespace program_cache
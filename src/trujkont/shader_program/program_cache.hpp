@@ -0,0 +1,130 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <string>
+#include <span>
+
+#include <tl/expected.hpp>
+
+#include "trujkont/shader_program/shader_program.hpp"
+#include "trujkont/shader_program/shader.hpp"
+
+// Process wide registry of linked programs, keyed by a hash of their stages' sources and the defines they were built with.
+// Asking for the same program twice compiles and links it once, the second caller just shares the first one's handle.
+// With `program_binary` enabled, programs built by earlier runs are relinked from their saved binaries instead.
+// Like `gl_state`, must only be used from the thread owning the GL context (the counters can be read from anywhere).
+namespace program_cache
+{
+
+using ProgramHandle = std::shared_ptr<ShaderProgram const>;
+
+struct StageSource
+{
+  ShaderType type;
+  std::string_view source;
+};
+
+struct StageFile
+{
+  ShaderType type;
+  std::filesystem::path path;
+};
+
+// Each define is put on its own `#define` line right below `#version`, e.g. `"MAX_LAYERS 16"`.
+using Defines = std::span<std::string_view const>;
+
+// Identifies the program built from `stages` and `defines`, the order of both matters.
+[[nodiscard]] auto program_key(std::span<StageSource const> stages, Defines defines = {}) -> std::uint64_t;
+
+// The error holds the compile or link log of whatever failed. Failed programs are not remembered.
+[[nodiscard]] auto get(std::span<StageSource const> stages, Defines defines = {}) -> tl::expected<ProgramHandle, std::string>;
+
+// Reads the stages every time (from the mounted asset pack when it has them, from disk otherwise),
+// but only compiles when their contents were not seen before.
+[[nodiscard]] auto load(std::span<StageFile const> stages, Defines defines = {}) -> tl::expected<ProgramHandle, std::string>;
+
+[[nodiscard]] auto read_shader_source(std::filesystem::path const& path) -> tl::expected<std::string, std::string>;
+
+class AsyncProgram;
+
+using AsyncProgramHandle = std::shared_ptr<AsyncProgram>;
+
+// Like `get`, but never waits for the driver. The stages are only submitted, the returned program keeps showing
+// `fallback` (which may be empty, meaning "skip drawing") until `poll` finds the real one linked.
+// Already cached programs are ready right away.
+[[nodiscard]] auto get_async(std::span<StageSource const> stages, Defines defines = {}, ProgramHandle fallback = nullptr) -> AsyncProgramHandle;
+
+// Reading the files still happens right here, only compiling is deferred.
+[[nodiscard]] auto load_async(std::span<StageFile const> stages, Defines defines = {}, ProgramHandle fallback = nullptr) -> tl::expected<AsyncProgramHandle, std::string>;
+
+// Meant to be called once per frame. Hands out every program the driver has finished linking in the background
+// (`GL_KHR_parallel_shader_compile`). Drivers without it cannot be asked without blocking, so there
+// a single program is finished per call instead, to at least spread the stalls over several frames.
+auto poll() -> void;
+
+[[nodiscard]] auto pending() -> std::size_t;
+
+struct ChangedFile
+{
+  std::filesystem::path path;
+  std::string source;
+};
+
+// Rebuilds, in the background like `get_async`, every program loaded with `load_async` that uses any of `changes`.
+// Each keeps drawing with what it has until `poll` swaps the new one in, so a frame never waits for a reload.
+// One that fails to compile is never swapped in at all, its `error` tells why.
+// Reloaded programs are not saved as binaries, and a program a reload replaced is deleted once nothing uses it anymore,
+// so editing shaders for a whole session doesn't pile up programs.
+auto reload(std::span<ChangedFile const> changes) -> void;
+
+// A program whose compile may still be in flight. Users draw with whatever `current` is at the moment,
+// and should re-resolve their `Uniform` handles whenever `generation` changes, since a different program took its place.
+class AsyncProgram
+{
+public:
+  // The fallback counts as a generation of its own, so its users resolve their uniforms for it too.
+  explicit AsyncProgram(ProgramHandle fallback)
+    : program(std::move(fallback)),
+      swaps(program ? 1 : 0)
+  {}
+
+  // Empty only while nothing, not even a fallback, is there to draw with.
+  [[nodiscard]] auto current() const noexcept -> ShaderProgram const* { return program.get(); }
+
+  [[nodiscard]] auto ready() const noexcept -> bool { return is_ready; }
+
+  [[nodiscard]] auto generation() const noexcept -> std::uint64_t { return swaps; }
+
+  // Compile or link log of the last failed attempt, the previous program (or fallback) is kept in that case.
+  [[nodiscard]] auto error() const noexcept -> std::string const& { return last_error; }
+
+private:
+  friend auto get_async(std::span<StageSource const> stages, Defines defines, ProgramHandle fallback) -> AsyncProgramHandle;
+  friend auto reload(std::span<ChangedFile const> changes) -> void;
+  friend auto poll() -> void;
+
+  // Returns the program it replaced.
+  auto swap_in(ProgramHandle linked) -> ProgramHandle
+  {
+    auto previous = std::exchange(program, std::move(linked));
+    is_ready = true;
+    last_error.clear();
+    ++swaps;
+
+    return previous;
+  }
+
+  ProgramHandle program;
+  bool is_ready = false;
+  std::uint64_t swaps = 0;
+  std::string last_error;
+};
+
+[[nodiscard]] auto report() -> std::string;
+
+} // namespace program_cache
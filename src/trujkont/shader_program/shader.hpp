@@ -30,9 +30,11 @@ public:
   Shader(ShaderType shader_type, std::string_view const shader_source)
     : id(glCreateShader(static_cast<GLenum>(shader_type)))
   {
+    // The length is passed along, so the source does not need to be null terminated.
     auto const source_ptr = shader_source.data();
+    auto const source_length = static_cast<GLint>(shader_source.size());
 
-    glShaderSource(id, 1, &source_ptr, nullptr);
+    glShaderSource(id, 1, &source_ptr, &source_length);
     glCompileShader(id);
   }
 
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <unordered_map>
 #include <string_view>
+#include <functional>
 #include <concepts>
+#include <cstring>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <string>
 #include <array>
+#include <span>
 
 #include "trujkont/shader_program/shader.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
 
 #include <glad/glad.h>
 
@@ -21,14 +30,87 @@ enum class ProgramAttr
   ActiveAttributes = GL_ACTIVE_ATTRIBUTES,
   ActiveAttributesMaxLength = GL_ACTIVE_ATTRIBUTE_MAX_LENGTH,
   ActiveUniforms = GL_ACTIVE_UNIFORMS,
-  ActiveUniformMaxLength = GL_ACTIVE_UNIFORM_MAX_LENGTH
+  ActiveUniformMaxLength = GL_ACTIVE_UNIFORM_MAX_LENGTH,
+  BinaryLength = GL_PROGRAM_BINARY_LENGTH
+};
+
+template<typename T>
+concept UniformValue = std::same_as<T, int>
+                       or std::same_as<T, unsigned int>
+                       or std::same_as<T, float>
+                       or std::same_as<T, glm::vec2>
+                       or std::same_as<T, glm::vec3>
+                       or std::same_as<T, glm::vec4>
+                       or std::same_as<T, glm::mat4>;
+
+// One active uniform of a linked program, together with the last value we uploaded to it.
+struct UniformSlot
+{
+  GLint location = -1;
+  GLenum type = GL_NONE;
+  GLint size = 0;
+
+  bool has_value = false;
+  std::array<std::byte, sizeof(glm::mat4)> last_value {};
+};
+
+// Typed handle to a single uniform. Resolved once, it uploads without any name lookups
+// and skips the `glUniform*` call altogether when the value did not change since the last upload.
+// An invalid handle (uniform not found or optimized out by the driver) silently ignores `set`, like GL does for location -1.
+template<UniformValue T>
+class Uniform
+{
+public:
+  Uniform() = default;
+
+  Uniform(GLuint const program_id, UniformSlot* const slot)
+    : program_id(program_id),
+      slot(slot)
+  {}
+
+  auto set(T const& value) const -> void
+  {
+    if(not slot) return;
+
+    if(slot->has_value and std::memcmp(slot->last_value.data(), &value, sizeof(T)) == 0) return;
+
+    std::memcpy(slot->last_value.data(), &value, sizeof(T));
+    slot->has_value = true;
+
+    gl_state::use_program(program_id);
+    upload(slot->location, value);
+  }
+
+  [[nodiscard]] auto valid() const noexcept -> bool
+  {
+    return slot != nullptr;
+  }
+
+private:
+  auto static upload(GLint const location, int const value) -> void { glUniform1i(location, value); }
+
+  auto static upload(GLint const location, unsigned int const value) -> void { glUniform1ui(location, value); }
+
+  auto static upload(GLint const location, float const value) -> void { glUniform1f(location, value); }
+
+  auto static upload(GLint const location, glm::vec2 const& value) -> void { glUniform2fv(location, 1, glm::value_ptr(value)); }
+
+  auto static upload(GLint const location, glm::vec3 const& value) -> void { glUniform3fv(location, 1, glm::value_ptr(value)); }
+
+  auto static upload(GLint const location, glm::vec4 const& value) -> void { glUniform4fv(location, 1, glm::value_ptr(value)); }
+
+  auto static upload(GLint const location, glm::mat4 const& value) -> void { glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value)); }
+
+  GLuint program_id = 0;
+  UniformSlot* slot = nullptr;
 };
 
 class ShaderProgram
 {
 public:
   ShaderProgram()
-    : id(glCreateProgram()) {};
+    : id(glCreateProgram()),
+      uniforms(std::make_shared<UniformTable>()) {};
 
   template<std::convertible_to<Shader>... Shaders>
   ShaderProgram(Shaders const... shaders)
@@ -39,6 +121,29 @@ public:
     glLinkProgram(id);
 
     (glDeleteShader(shaders.id), ...);
+
+    introspect_uniforms();
+  }
+
+  // Takes over `linked_program`, whose link was started (and has succeeded) elsewhere, e.g. by a compile queue
+  // that did not want to wait for it right away.
+  struct AdoptLinked {};
+
+  ShaderProgram(AdoptLinked /*tag*/, GLuint const linked_program)
+    : id(linked_program),
+      uniforms(std::make_shared<UniformTable>())
+  {
+    introspect_uniforms();
+  }
+
+  // Relinks a program from what `glGetProgramBinary` returned earlier. The driver may reject it
+  // (e.g. after an update), which shows up as a failed link, exactly like a failed compile would.
+  ShaderProgram(GLenum const binary_format, std::span<std::byte const> const binary)
+    : ShaderProgram()
+  {
+    glProgramBinary(id, binary_format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    if(param<ProgramAttr::LinkStatus>() == GL_TRUE) introspect_uniforms();
   }
 
   template<ProgramAttr ProgramAttr>
@@ -65,42 +170,96 @@ public:
     return str;
   }
 
-  auto set_uniform_2f(std::string_view const name, float const first, float const second) const
+  template<UniformValue T>
+  [[nodiscard]] auto uniform(std::string_view const name) const -> Uniform<T>
   {
-    auto const uniform_loc = glGetUniformLocation(id, name.data());
+    return Uniform<T>(id, find_uniform(name));
+  }
 
-    use();
-    glUniform2f(uniform_loc, first, second);
+  auto set_uniform_2f(std::string_view const name, float const first, float const second) const
+  {
+    uniform<glm::vec2>(name).set(glm::vec2(first, second));
   }
 
   auto set_uniform_1i(std::string_view const name, int const value) const
   {
-    auto const uniform_loc = glGetUniformLocation(id, name.data());
-
-    use();
-    glUniform1i(uniform_loc, value);
+    uniform<int>(name).set(value);
   }
 
   auto set_uniform_1ui(std::string_view const name, unsigned int const value) const
   {
-    auto const uniform_loc = glGetUniformLocation(id, name.data());
-
-    use();
-    glUniform1ui(uniform_loc, value);
+    uniform<unsigned int>(name).set(value);
   }
 
-  auto set_uniform_4mat(std::string_view const name, glm::mat4 mat) const
+  auto set_uniform_4mat(std::string_view const name, glm::mat4 const& mat) const
   {
-    auto const uniform_loc = glGetUniformLocation(id, name.data());
-
-    use();
-    glUniformMatrix4fv(uniform_loc, 1, GL_FALSE, glm::value_ptr(mat));
+    uniform<glm::mat4>(name).set(mat);
   }
 
   auto use() const -> void
   {
-    glUseProgram(id);
+    gl_state::use_program(id);
   }
 
   GLuint id;
+
+private:
+  struct NameHash
+  {
+    using is_transparent = void;
+
+    auto operator()(std::string_view const name) const noexcept -> std::size_t
+    {
+      return std::hash<std::string_view>()(name);
+    }
+  };
+
+  // Kept behind a shared pointer, so handles stay valid when the program object is moved
+  // and copies of a program (which share the GL object) also share the uploaded values.
+  struct UniformTable
+  {
+    std::vector<UniformSlot> slots;
+    std::unordered_map<std::string, std::size_t, NameHash, std::equal_to<>> indices;
+  };
+
+  [[nodiscard]] auto find_uniform(std::string_view const name) const -> UniformSlot*
+  {
+    auto const it = uniforms->indices.find(name);
+
+    return it == uniforms->indices.end() ? nullptr : &uniforms->slots[it->second];
+  }
+
+  auto introspect_uniforms() -> void
+  {
+    auto const uniforms_count = param<ProgramAttr::ActiveUniforms>();
+    auto const max_name_length = param<ProgramAttr::ActiveUniformMaxLength>();
+
+    uniforms->slots.reserve(uniforms_count);
+
+    auto name = std::string(max_name_length, '\0');
+
+    for(auto i = 0U; i < uniforms_count; ++i) {
+      auto slot = UniformSlot();
+      auto name_length = GLsizei(0);
+
+      glGetActiveUniform(id, i, static_cast<GLsizei>(name.size()), &name_length, &slot.size, &slot.type, name.data());
+
+      auto const uniform_name = std::string_view(name.data(), name_length);
+      slot.location = glGetUniformLocation(id, name.data());
+
+      // Uniform block members have no location, they are fed through buffers instead.
+      if(slot.location == -1) continue;
+
+      uniforms->indices.emplace(uniform_name, uniforms->slots.size());
+
+      // Arrays are reported as `name[0]`, but are usually referred to by their bare name.
+      if(uniform_name.ends_with("[0]")) {
+        uniforms->indices.emplace(uniform_name.substr(0, uniform_name.size() - 3), uniforms->slots.size());
+      }
+
+      uniforms->slots.push_back(slot);
+    }
+  }
+
+  std::shared_ptr<UniformTable> uniforms;
 };
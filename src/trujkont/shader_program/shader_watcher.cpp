@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <utility>
+#include <array>
+
+#include "trujkont/shader_program/shader_watcher.hpp"
+
+#include <fmt/format.h>
+
+#if defined(__linux__)
+  #include <sys/inotify.h>
+  #include <unistd.h>
+  #include <poll.h>
+#endif
+
+namespace
+{
+
+auto constexpr shader_extensions = std::array { ".vert", ".frag", ".comp", ".geom", ".tesc", ".tese", ".glsl" };
+
+// Editors tend to write swap and backup files next to the real ones.
+auto is_shader(std::filesystem::path const& path) -> bool
+{
+  return std::ranges::find(shader_extensions, path.extension().string()) != shader_extensions.end();
+}
+
+} // namespace
+
+#if defined(__linux__)
+
+ShaderWatcher::ShaderWatcher(std::filesystem::path directory)
+  : directory(std::move(directory)),
+    inotify_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+  if(inotify_fd == -1) return;
+
+  // Editors either write the file in place or write a new one and move it over the old one.
+  watch = inotify_add_watch(inotify_fd, this->directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+  if(watch == -1) {
+    fmt::print(stderr, "Cannot watch shaders @ path: \"{}\"\n", this->directory.c_str());
+    return;
+  }
+
+  thread = std::jthread([this](std::stop_token const& stop) { run(stop); });
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+  if(thread.joinable()) {
+    thread.request_stop();
+    thread.join();
+  }
+
+  if(inotify_fd != -1) close(inotify_fd);
+}
+
+auto ShaderWatcher::watching() const noexcept -> bool
+{
+  return watch != -1;
+}
+
+auto ShaderWatcher::run(std::stop_token const& stop) -> void
+{
+  // Aligned like `inotify_event`, which the buffer is read as, and large enough for at least one event with the longest name.
+  alignas(inotify_event) auto buffer = std::array<char, 16 * (sizeof(inotify_event) + NAME_MAX + 1)>();
+
+  // Wakes up every now and then to notice the stop request, there is nothing to be woken up by otherwise.
+  auto constexpr stop_check_interval_ms = 100;
+
+  while(not stop.stop_requested()) {
+    auto descriptor = pollfd { .fd = inotify_fd, .events = POLLIN, .revents = 0 };
+    if(::poll(&descriptor, 1, stop_check_interval_ms) <= 0) continue;
+
+    auto const length = read(inotify_fd, buffer.data(), buffer.size());
+    if(length <= 0) continue;
+
+    for(auto offset = std::size_t(0); offset < static_cast<std::size_t>(length);) {
+      auto const* const event = reinterpret_cast<inotify_event const*>(buffer.data() + offset); // NOLINT
+      offset += sizeof(inotify_event) + event->len;
+
+      if(event->len == 0 or (event->mask & IN_ISDIR) != 0) continue;
+
+      add_change(directory / event->name); // NOLINT
+    }
+  }
+}
+
+#else
+
+ShaderWatcher::ShaderWatcher(std::filesystem::path directory)
+  : directory(std::move(directory))
+{}
+
+ShaderWatcher::~ShaderWatcher() = default;
+
+auto ShaderWatcher::watching() const noexcept -> bool
+{
+  return false;
+}
+
+auto ShaderWatcher::run([[maybe_unused]] std::stop_token const& stop) -> void {}
+
+#endif
+
+auto ShaderWatcher::take_changes() -> std::vector<program_cache::ChangedFile>
+{
+  auto const lock = std::scoped_lock(changes_mutex);
+
+  return std::exchange(changes, {});
+}
+
+auto ShaderWatcher::add_change(std::filesystem::path path) -> void
+{
+  if(not is_shader(path)) return;
+
+  // Read here rather than on the main thread, which only has to compile what's already in memory.
+  auto source = program_cache::read_shader_source(path);
+  if(not source) return;
+
+  auto const lock = std::scoped_lock(changes_mutex);
+
+  auto const same_file = std::ranges::find(changes, path, &program_cache::ChangedFile::path);
+  if(same_file != changes.end()) {
+    same_file->source = std::move(*source);
+    return;
+  }
+
+  changes.push_back({ .path = std::move(path), .source = std::move(*source) });
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+#include "trujkont/shader_program/program_cache.hpp"
+
+// Watches a directory of shaders (with inotify, so only on Linux, elsewhere it never reports anything)
+// and re-reads every shader written or moved into it on its own thread. The main thread only picks up
+// the finished sources with `take_changes`, once per frame, and hands them to `program_cache::reload`.
+class ShaderWatcher
+{
+public:
+  explicit ShaderWatcher(std::filesystem::path directory);
+
+  ShaderWatcher(ShaderWatcher const&) = delete;
+  ShaderWatcher(ShaderWatcher&&) = delete;
+  auto operator=(ShaderWatcher const&) -> ShaderWatcher& = delete;
+  auto operator=(ShaderWatcher&&) -> ShaderWatcher& = delete;
+
+  ~ShaderWatcher();
+
+  // False when the platform has no inotify or the directory could not be watched.
+  [[nodiscard]] auto watching() const noexcept -> bool;
+
+  // Everything that changed since the last call, each file at most once, with its newest contents.
+  [[nodiscard]] auto take_changes() -> std::vector<program_cache::ChangedFile>;
+
+private:
+  auto run(std::stop_token const& stop) -> void;
+
+  auto add_change(std::filesystem::path path) -> void;
+
+  std::filesystem::path directory;
+
+  int inotify_fd = -1;
+  int watch = -1;
+
+  std::mutex changes_mutex;
+  std::vector<program_cache::ChangedFile> changes;
+
+  // Last, so it's stopped and joined before anything it uses goes away.
+  std::jthread thread;
+};
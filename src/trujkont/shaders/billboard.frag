@@ -1,14 +1,16 @@
 #version 450 core
 
-layout (location = 2) in vec2 texture_coords;
+layout (location = 2) in vec3 texture_coords;
+layout (location = 3) in vec4 tint;
 
 out vec4 out_frag_color;
 
-uniform sampler2D billboard_texture;
+uniform sampler2DArray billboard_textures;
 
 void main()
 {
-  out_frag_color = texture(billboard_texture, texture_coords);
+  // The texture's alpha is premultiplied, so the tint's has to be too.
+  out_frag_color = texture(billboard_textures, texture_coords) * vec4(tint.rgb * tint.a, tint.a);
 }
 
 // vim: ft=glsl
@@ -1,17 +1,40 @@
 #version 450 core
 
-layout (location = 0) in vec3 position;
+layout (location = 0) in vec3 corner;
 layout (location = 1) in vec2 texture_coords;
 
-layout (location = 2) out vec2 out_texture_coords;
+// Per billboard.
+layout (location = 2) in vec4 position_size;
+layout (location = 3) in uint layer;
+layout (location = 4) in vec4 tint;
 
-uniform mat4 projection;
-uniform mat4 no_rotation_model_view_mat;
+// Of the layer, for sprites packed into an atlas: `xy` the lower left corner, `zw` the upper right one.
+layout (location = 5) in vec4 region;
+
+layout (location = 2) out vec3 out_texture_coords;
+layout (location = 3) out vec4 out_tint;
+
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 view;
+  mat4 projection;
+  mat4 view_projection;
+  vec4 camera_position;
+  vec4 camera_right;
+  vec4 camera_up;
+};
+
+// Quad::half_extent, the corners are stored in [-1, 1].
+const float quad_half_extent = 0.5;
 
 void main()
 {
-  gl_Position = projection * no_rotation_model_view_mat * vec4(position, 1.0f);
-  out_texture_coords = texture_coords;
+  // The quad's corners are spread along the camera's own axes, so it always faces the camera.
+  vec3 offset = (camera_right.xyz * corner.x + camera_up.xyz * corner.y) * quad_half_extent * position_size.w;
+
+  gl_Position = view_projection * vec4(position_size.xyz + offset, 1.0f);
+  out_texture_coords = vec3(mix(region.xy, region.zw, texture_coords), float(layer));
+  out_tint = tint;
 }
 
 // vim: ft=glsl
@@ -0,0 +1,14 @@
+#version 450 core
+
+layout(location = 2) in vec2 texture_coords;
+
+out vec4 frag_color;
+
+uniform sampler2D face_texture;
+
+void main()
+{
+  frag_color = texture(face_texture, texture_coords);
+}
+
+// vim: ft=glsl
@@ -0,0 +1,28 @@
+#version 450 core
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec2 texture_coords;
+layout (location = 3) in mat4 model;
+
+layout (location = 2) out vec2 out_texture_coords;
+
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 view;
+  mat4 projection;
+  mat4 view_projection;
+  vec4 camera_position;
+  vec4 camera_right;
+  vec4 camera_up;
+};
+
+// InstancedCubes::half_extent, the positions are stored in [-1, 1].
+const float cube_half_extent = 0.5;
+
+void main()
+{
+  gl_Position = view_projection * model * vec4(pos * cube_half_extent, 1.0);
+  out_texture_coords = texture_coords;
+}
+
+// vim: ft=glsl
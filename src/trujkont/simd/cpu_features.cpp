@@ -0,0 +1,79 @@
+#include "trujkont/simd/cpu_features.hpp"
+
+#include <array>
+
+#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+  #include <intrin.h>
+  #include <immintrin.h>
+#endif
+
+namespace
+{
+
+auto detect() -> CpuFeatures
+{
+  auto features = CpuFeatures();
+
+#if(defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+  __builtin_cpu_init();
+
+  // These also account for the OS saving the wide registers, not just for the CPU having them.
+  features.sse2 = __builtin_cpu_supports("sse2") != 0;
+  features.ssse3 = __builtin_cpu_supports("ssse3") != 0;
+  features.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+  features.avx2 = __builtin_cpu_supports("avx2") != 0;
+  features.fma = __builtin_cpu_supports("fma") != 0;
+#elif defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+  auto regs = std::array<int, 4>();
+
+  __cpuid(regs.data(), 1);
+  auto const ecx1 = regs[2];
+  auto const edx1 = regs[3];
+
+  features.sse2 = (edx1 & (1 << 26)) != 0;
+  features.ssse3 = (ecx1 & (1 << 9)) != 0;
+  features.sse41 = (ecx1 & (1 << 19)) != 0;
+  features.fma = (ecx1 & (1 << 12)) != 0;
+
+  auto const os_saves_ymm = (ecx1 & (1 << 27)) != 0 and (_xgetbv(0) & 0x6) == 0x6;
+
+  __cpuidex(regs.data(), 7, 0);
+  features.avx2 = os_saves_ymm and (regs[1] & (1 << 5)) != 0;
+  features.fma = features.fma and os_saves_ymm;
+#endif
+
+  return features;
+}
+
+} // namespace
+
+auto cpu_features() -> CpuFeatures const&
+{
+  auto static const features = detect();
+
+  return features;
+}
+
+auto best_simd_level() -> SimdLevel
+{
+#if defined(TRUJKONT_AVX2_KERNELS)
+  if(cpu_features().avx2 and cpu_features().fma) return SimdLevel::Avx2;
+#endif
+
+#if defined(__SSE2__) or defined(_M_X64)
+  return SimdLevel::Sse;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+auto simd_level_name(SimdLevel const level) -> char const*
+{
+  switch(level) {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::Sse: return "sse";
+    case SimdLevel::Avx2: return "avx2";
+  }
+
+  return "unknown";
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+enum class SimdLevel
+{
+  Scalar,
+  Sse,
+  Avx2
+};
+
+struct CpuFeatures
+{
+  bool sse2 = false;
+  bool ssse3 = false;
+  bool sse41 = false;
+  bool avx2 = false;
+  bool fma = false;
+};
+
+// Detected once, on first use.
+[[nodiscard]] auto cpu_features() -> CpuFeatures const&;
+
+// The widest kernel flavour that is both compiled in and supported by the running CPU (and OS).
+[[nodiscard]] auto best_simd_level() -> SimdLevel;
+
+[[nodiscard]] auto simd_level_name(SimdLevel level) -> char const*;
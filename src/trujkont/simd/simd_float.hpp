@@ -0,0 +1,236 @@
+#pragma once
+
+// Minimal fixed-width float vector abstractions the batch kernels are written against, so each kernel is written once
+// and instantiated per instruction set. `ScalarFloats` doubles as the tail loop and as the fallback for non x86 targets.
+//
+// Everything here deliberately has internal linkage and uses no standard library templates: kernel translation units
+// are compiled with different target flags, and sharing any inline symbol between them would let the linker pick
+// e.g. an AVX2 encoded copy for code that runs on every CPU.
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__SSE2__) or defined(_M_X64)
+  #define TRUJKONT_SSE_KERNELS
+  #include <emmintrin.h>
+#endif
+
+namespace // NOLINT(cert-dcl59-cpp): see above
+{
+
+struct ScalarFloats
+{
+  using Float = float;
+  using Int = std::int32_t;
+
+  auto inline static constexpr width = std::size_t(1);
+
+  auto static set1(float const value) -> Float { return value; }
+
+  auto static load(float const* const source) -> Float { return *source; }
+
+  auto static store(float* const destination, Float const value) -> void { *destination = value; }
+
+  auto static gather(float const* const base, std::uint32_t const* const indices) -> Float { return base[*indices]; }
+
+  auto static add(Float const a, Float const b) -> Float { return a + b; }
+
+  auto static sub(Float const a, Float const b) -> Float { return a - b; }
+
+  auto static mul(Float const a, Float const b) -> Float { return a * b; }
+
+  auto static fmadd(Float const a, Float const b, Float const c) -> Float { return a * b + c; }
+
+  auto static sqrt(Float const value) -> Float
+  {
+#if defined(TRUJKONT_SSE_KERNELS)
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+    return __builtin_sqrtf(value);
+#endif
+  }
+
+  auto static min(Float const a, Float const b) -> Float { return a < b ? a : b; }
+
+  auto static max(Float const a, Float const b) -> Float { return a < b ? b : a; }
+
+  auto static bits(Float const value) -> std::uint32_t
+  {
+    auto result = std::uint32_t();
+    std::memcpy(&result, &value, sizeof(result));
+
+    return result;
+  }
+
+  auto static from_bits(std::uint32_t const value) -> Float
+  {
+    auto result = Float();
+    std::memcpy(&result, &value, sizeof(result));
+
+    return result;
+  }
+
+  auto static bit_and(Float const a, Float const b) -> Float { return from_bits(bits(a) & bits(b)); }
+
+  auto static bit_andnot(Float const a, Float const b) -> Float { return from_bits(~bits(a) & bits(b)); }
+
+  auto static bit_or(Float const a, Float const b) -> Float { return from_bits(bits(a) | bits(b)); }
+
+  auto static bit_xor(Float const a, Float const b) -> Float { return from_bits(bits(a) ^ bits(b)); }
+
+  // All bits set where `a < b`.
+  auto static less(Float const a, Float const b) -> Float { return from_bits(a < b ? ~0U : 0U); }
+
+  // One bit per lane, set where the lane's sign bit is set.
+  auto static mask(Float const value) -> int { return static_cast<int>(bits(value) >> 31U); }
+
+  auto static truncate(Float const value) -> Int { return static_cast<Int>(value); }
+
+  auto static to_float(Int const value) -> Float { return static_cast<Float>(value); }
+
+  auto static set1_int(std::int32_t const value) -> Int { return value; }
+
+  auto static add_int(Int const a, Int const b) -> Int { return a + b; }
+
+  auto static and_int(Int const a, Int const b) -> Int { return a & b; }
+
+  auto static andnot_int(Int const a, Int const b) -> Int { return ~a & b; }
+
+  auto static equal_int(Int const a, Int const b) -> Int { return a == b ? ~0 : 0; }
+
+  template<int Bits>
+  auto static shift_left_int(Int const value) -> Int
+  {
+    return static_cast<Int>(static_cast<std::uint32_t>(value) << Bits);
+  }
+
+  auto static int_bits_as_float(Int const value) -> Float { return from_bits(static_cast<std::uint32_t>(value)); }
+
+  // `width` consecutive bytes, zero extended into the lanes.
+  auto static load_bytes(std::uint8_t const* const source) -> Int { return *source; }
+
+  // The lanes, which have to be in [0, 255], as `width` consecutive bytes.
+  auto static store_bytes(std::uint8_t* const destination, Int const value) -> void { *destination = static_cast<std::uint8_t>(value); }
+
+  // `table[index]` for each lane's index.
+  auto static lookup(float const* const table, Int const indices) -> Float { return table[indices]; }
+
+  // Writes lane `i` of the four vectors as four consecutive floats at `destination + i * stride`.
+  auto static store_transposed(float* const destination, std::size_t, Float const a, Float const b, Float const c, Float const d) -> void
+  {
+    destination[0] = a;
+    destination[1] = b;
+    destination[2] = c;
+    destination[3] = d;
+  }
+};
+
+#if defined(TRUJKONT_SSE_KERNELS)
+
+struct SseFloats
+{
+  using Float = __m128;
+  using Int = __m128i;
+
+  auto inline static constexpr width = std::size_t(4);
+
+  auto static set1(float const value) -> Float { return _mm_set1_ps(value); }
+
+  auto static load(float const* const source) -> Float { return _mm_loadu_ps(source); }
+
+  auto static store(float* const destination, Float const value) -> void { _mm_storeu_ps(destination, value); }
+
+  auto static gather(float const* const base, std::uint32_t const* const indices) -> Float
+  {
+    return _mm_setr_ps(base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]]);
+  }
+
+  auto static add(Float const a, Float const b) -> Float { return _mm_add_ps(a, b); }
+
+  auto static sub(Float const a, Float const b) -> Float { return _mm_sub_ps(a, b); }
+
+  auto static mul(Float const a, Float const b) -> Float { return _mm_mul_ps(a, b); }
+
+  auto static fmadd(Float const a, Float const b, Float const c) -> Float { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+  auto static sqrt(Float const value) -> Float { return _mm_sqrt_ps(value); }
+
+  auto static min(Float const a, Float const b) -> Float { return _mm_min_ps(a, b); }
+
+  auto static max(Float const a, Float const b) -> Float { return _mm_max_ps(a, b); }
+
+  auto static bit_and(Float const a, Float const b) -> Float { return _mm_and_ps(a, b); }
+
+  auto static bit_andnot(Float const a, Float const b) -> Float { return _mm_andnot_ps(a, b); }
+
+  auto static bit_or(Float const a, Float const b) -> Float { return _mm_or_ps(a, b); }
+
+  auto static bit_xor(Float const a, Float const b) -> Float { return _mm_xor_ps(a, b); }
+
+  auto static less(Float const a, Float const b) -> Float { return _mm_cmplt_ps(a, b); }
+
+  auto static mask(Float const value) -> int { return _mm_movemask_ps(value); }
+
+  auto static truncate(Float const value) -> Int { return _mm_cvttps_epi32(value); }
+
+  auto static to_float(Int const value) -> Float { return _mm_cvtepi32_ps(value); }
+
+  auto static set1_int(std::int32_t const value) -> Int { return _mm_set1_epi32(value); }
+
+  auto static add_int(Int const a, Int const b) -> Int { return _mm_add_epi32(a, b); }
+
+  auto static and_int(Int const a, Int const b) -> Int { return _mm_and_si128(a, b); }
+
+  auto static andnot_int(Int const a, Int const b) -> Int { return _mm_andnot_si128(a, b); }
+
+  auto static equal_int(Int const a, Int const b) -> Int { return _mm_cmpeq_epi32(a, b); }
+
+  template<int Bits>
+  auto static shift_left_int(Int const value) -> Int
+  {
+    return _mm_slli_epi32(value, Bits);
+  }
+
+  auto static int_bits_as_float(Int const value) -> Float { return _mm_castsi128_ps(value); }
+
+  auto static load_bytes(std::uint8_t const* const source) -> Int
+  {
+    auto bytes = std::int32_t();
+    std::memcpy(&bytes, source, sizeof(bytes));
+
+    auto const zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+  }
+
+  auto static store_bytes(std::uint8_t* const destination, Int const value) -> void
+  {
+    auto const words = _mm_packs_epi32(value, value);
+    auto const bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+
+    std::memcpy(destination, &bytes, sizeof(bytes));
+  }
+
+  // No gathers before AVX2, the indices go through memory.
+  auto static lookup(float const* const table, Int const indices) -> Float
+  {
+    alignas(16) std::int32_t lanes[4]; // NOLINT(*-avoid-c-arrays)
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices); // NOLINT
+
+    return _mm_setr_ps(table[lanes[0]], table[lanes[1]], table[lanes[2]], table[lanes[3]]);
+  }
+
+  auto static store_transposed(float* const destination, std::size_t const stride, Float a, Float b, Float c, Float d) -> void
+  {
+    _MM_TRANSPOSE4_PS(a, b, c, d); // NOLINT
+
+    _mm_storeu_ps(destination, a);
+    _mm_storeu_ps(destination + stride, b);
+    _mm_storeu_ps(destination + 2 * stride, c);
+    _mm_storeu_ps(destination + 3 * stride, d);
+  }
+};
+
+#endif
+
+} // namespace
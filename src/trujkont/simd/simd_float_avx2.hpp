@@ -0,0 +1,121 @@
+#pragma once
+
+// AVX2 + FMA flavour of the vector abstractions in `simd_float.hpp`.
+// Only to be included from translation units compiled with AVX2 and FMA enabled (the `avx2_kernels` library).
+
+#if not defined(__AVX2__) or not defined(__FMA__)
+  #error "simd_float_avx2.hpp needs to be compiled with AVX2 and FMA enabled"
+#endif
+
+#include <immintrin.h>
+
+#include "trujkont/simd/simd_float.hpp"
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+struct Avx2Floats
+{
+  using Float = __m256;
+  using Int = __m256i;
+
+  auto inline static constexpr width = std::size_t(8);
+
+  auto static set1(float const value) -> Float { return _mm256_set1_ps(value); }
+
+  auto static load(float const* const source) -> Float { return _mm256_loadu_ps(source); }
+
+  auto static store(float* const destination, Float const value) -> void { _mm256_storeu_ps(destination, value); }
+
+  auto static gather(float const* const base, std::uint32_t const* const indices) -> Float
+  {
+    auto const offsets = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(indices)); // NOLINT
+
+    return _mm256_i32gather_ps(base, offsets, 4);
+  }
+
+  auto static add(Float const a, Float const b) -> Float { return _mm256_add_ps(a, b); }
+
+  auto static sub(Float const a, Float const b) -> Float { return _mm256_sub_ps(a, b); }
+
+  auto static mul(Float const a, Float const b) -> Float { return _mm256_mul_ps(a, b); }
+
+  auto static fmadd(Float const a, Float const b, Float const c) -> Float { return _mm256_fmadd_ps(a, b, c); }
+
+  auto static sqrt(Float const value) -> Float { return _mm256_sqrt_ps(value); }
+
+  auto static min(Float const a, Float const b) -> Float { return _mm256_min_ps(a, b); }
+
+  auto static max(Float const a, Float const b) -> Float { return _mm256_max_ps(a, b); }
+
+  auto static bit_and(Float const a, Float const b) -> Float { return _mm256_and_ps(a, b); }
+
+  auto static bit_andnot(Float const a, Float const b) -> Float { return _mm256_andnot_ps(a, b); }
+
+  auto static bit_or(Float const a, Float const b) -> Float { return _mm256_or_ps(a, b); }
+
+  auto static bit_xor(Float const a, Float const b) -> Float { return _mm256_xor_ps(a, b); }
+
+  auto static less(Float const a, Float const b) -> Float { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+
+  auto static mask(Float const value) -> int { return _mm256_movemask_ps(value); }
+
+  auto static truncate(Float const value) -> Int { return _mm256_cvttps_epi32(value); }
+
+  auto static to_float(Int const value) -> Float { return _mm256_cvtepi32_ps(value); }
+
+  auto static set1_int(std::int32_t const value) -> Int { return _mm256_set1_epi32(value); }
+
+  auto static add_int(Int const a, Int const b) -> Int { return _mm256_add_epi32(a, b); }
+
+  auto static and_int(Int const a, Int const b) -> Int { return _mm256_and_si256(a, b); }
+
+  auto static andnot_int(Int const a, Int const b) -> Int { return _mm256_andnot_si256(a, b); }
+
+  auto static equal_int(Int const a, Int const b) -> Int { return _mm256_cmpeq_epi32(a, b); }
+
+  template<int Bits>
+  auto static shift_left_int(Int const value) -> Int
+  {
+    return _mm256_slli_epi32(value, Bits);
+  }
+
+  auto static int_bits_as_float(Int const value) -> Float { return _mm256_castsi256_ps(value); }
+
+  auto static load_bytes(std::uint8_t const* const source) -> Int
+  {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(source))); // NOLINT
+  }
+
+  auto static store_bytes(std::uint8_t* const destination, Int const value) -> void
+  {
+    auto const words = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(words, words)); // NOLINT
+  }
+
+  auto static lookup(float const* const table, Int const indices) -> Float { return _mm256_i32gather_ps(table, indices, 4); }
+
+  // Lanes 0-3 and 4-7 are transposed separately, the 128-bit halves of an AVX register don't mix cheaply.
+  auto static store_transposed(float* const destination, std::size_t const stride, Float const a, Float const b, Float const c, Float const d) -> void
+  {
+    SseFloats::store_transposed(
+      destination,
+      stride,
+      _mm256_castps256_ps128(a),
+      _mm256_castps256_ps128(b),
+      _mm256_castps256_ps128(c),
+      _mm256_castps256_ps128(d)
+    );
+
+    SseFloats::store_transposed(
+      destination + 4 * stride,
+      stride,
+      _mm256_extractf128_ps(a, 1),
+      _mm256_extractf128_ps(b, 1),
+      _mm256_extractf128_ps(c, 1),
+      _mm256_extractf128_ps(d, 1)
+    );
+  }
+};
+
+} // namespace
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "trujkont/simd/simd_float.hpp"
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+// Cephes style sine and cosine of every lane at once, accurate to a couple of ulps for |x| up to a few thousand.
+// Both share the range reduction to [-pi/4, pi/4] and pick between the two minimax polynomials per lane.
+template<typename V>
+auto sincos(typename V::Float x, typename V::Float& sine, typename V::Float& cosine) -> void
+{
+  using Float = typename V::Float;
+
+  auto const sign_mask = V::set1(-0.0F);
+
+  auto sine_sign = V::bit_and(x, sign_mask);
+  x = V::bit_andnot(sign_mask, x);
+
+  // Octant of x, rounded up to even, so the reduced argument lands in [-pi/4, pi/4].
+  auto octant = V::truncate(V::mul(x, V::set1(1.27323954473516F)));
+  octant = V::and_int(V::add_int(octant, V::set1_int(1)), V::set1_int(~1));
+  auto const y = V::to_float(octant);
+
+  auto const sine_swap = V::int_bits_as_float(V::template shift_left_int<29>(V::and_int(octant, V::set1_int(4))));
+  auto const polynomial_mask = V::int_bits_as_float(V::equal_int(V::and_int(octant, V::set1_int(2)), V::set1_int(0)));
+  auto const cosine_sign = V::int_bits_as_float(
+    V::template shift_left_int<29>(V::andnot_int(V::add_int(octant, V::set1_int(-2)), V::set1_int(4)))
+  );
+
+  sine_sign = V::bit_xor(sine_sign, sine_swap);
+
+  // Extended precision x - y * pi/4.
+  x = V::fmadd(y, V::set1(-0.78515625F), x);
+  x = V::fmadd(y, V::set1(-2.4187564849853515625e-4F), x);
+  x = V::fmadd(y, V::set1(-3.77489497744594108e-8F), x);
+
+  auto const z = V::mul(x, x);
+
+  auto cosine_poly = V::set1(2.443315711809948E-005F);
+  cosine_poly = V::fmadd(cosine_poly, z, V::set1(-1.388731625493765E-003F));
+  cosine_poly = V::fmadd(cosine_poly, z, V::set1(4.166664568298827E-002F));
+  cosine_poly = V::mul(V::mul(cosine_poly, z), z);
+  cosine_poly = V::fmadd(z, V::set1(-0.5F), cosine_poly);
+  cosine_poly = V::add(cosine_poly, V::set1(1.0F));
+
+  auto sine_poly = V::set1(-1.9515295891E-4F);
+  sine_poly = V::fmadd(sine_poly, z, V::set1(8.3321608736E-3F));
+  sine_poly = V::fmadd(sine_poly, z, V::set1(-1.6666654611E-1F));
+  sine_poly = V::fmadd(V::mul(sine_poly, z), x, x);
+
+  Float const sine_part = V::bit_or(V::bit_and(polynomial_mask, sine_poly), V::bit_andnot(polynomial_mask, cosine_poly));
+  Float const cosine_part = V::bit_or(V::bit_andnot(polynomial_mask, sine_poly), V::bit_and(polynomial_mask, cosine_poly));
+
+  sine = V::bit_xor(sine_part, sine_sign);
+  cosine = V::bit_xor(cosine_part, cosine_sign);
+}
+
+} // namespace
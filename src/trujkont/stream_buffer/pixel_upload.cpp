@@ -0,0 +1,16 @@
+#include "trujkont/stream_buffer/pixel_upload.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+PixelUploadFrame::PixelUploadFrame(StreamBuffer& stream, std::size_t const budget)
+  : stream(stream),
+    budget(budget)
+{
+  gl_state::bind_buffer(GL_PIXEL_UNPACK_BUFFER, stream.id());
+}
+
+PixelUploadFrame::~PixelUploadFrame()
+{
+  // Left bound, it would turn the pointers passed by every other upload into offsets into the stream.
+  gl_state::bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
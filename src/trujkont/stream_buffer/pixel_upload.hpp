@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+#include <glad/glad.h>
+
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+
+// Rows of one batch, already copied into the stream.
+struct StagedRows
+{
+  int first_row = 0;
+  int rows = 0;
+
+  // Offset into the stream, what `glTexSubImage2D` and friends take in place of a pointer while it's the unpack buffer.
+  void const* pixels = nullptr;
+  std::size_t size = 0;
+};
+
+// One frame's texture uploads through the frame's `StreamBuffer` region, which is bound as the pixel unpack buffer for as
+// long as this lives, so the copies come from GPU visible memory without stalling on the driver's. At most `budget` bytes
+// are uploaded, whatever is left goes in later frames, so uploading many (or huge) images never stalls one.
+// Nothing else may upload pixels from client memory while one is alive.
+class PixelUploadFrame
+{
+public:
+  PixelUploadFrame(StreamBuffer& stream, std::size_t budget);
+
+  PixelUploadFrame(PixelUploadFrame const&) = delete;
+  PixelUploadFrame(PixelUploadFrame&&) = delete;
+  auto operator=(PixelUploadFrame const&) -> PixelUploadFrame& = delete;
+  auto operator=(PixelUploadFrame&&) -> PixelUploadFrame& = delete;
+
+  ~PixelUploadFrame();
+
+  // Stages rows `rows_uploaded` .. `rows_count` of `bytes`, `row_size` bytes each (the last one may be shorter), in batches
+  // and calls `upload(StagedRows const&)` for every one to copy it into the bound texture, advancing `rows_uploaded`.
+  // Returns false once the frame's budget or the stream's region ran out, before all the rows were uploaded.
+  template<typename Upload>
+  auto upload_rows(std::span<std::byte const> const bytes, std::size_t const row_size, int const rows_count, int& rows_uploaded, Upload&& upload)
+    -> bool
+  {
+    while(rows_uploaded < rows_count) {
+      // The frame's first rows go in even when one alone is over the budget, so huge images still make progress.
+      if(budget < row_size and uploaded_anything) return false;
+
+      auto const rows_left = static_cast<std::size_t>(rows_count - rows_uploaded);
+      auto const rows = std::min(rows_left, std::max(budget / row_size, std::size_t(1)));
+
+      auto const first_byte = static_cast<std::size_t>(rows_uploaded) * row_size;
+      auto const size = std::min(rows * row_size, bytes.size() - first_byte);
+
+      auto staging = stream.allocate<std::byte>(size);
+      if(not staging) return false;
+
+      std::memcpy(staging->data.data(), bytes.data() + first_byte, size);
+
+      upload(StagedRows {
+        .first_row = rows_uploaded,
+        .rows = static_cast<int>(rows),
+        .pixels = reinterpret_cast<void const*>(staging->offset), // NOLINT
+        .size = size,
+      });
+
+      rows_uploaded += static_cast<int>(rows);
+      budget -= std::min(budget, size);
+      uploaded_anything = true;
+    }
+
+    return true;
+  }
+
+private:
+  StreamBuffer& stream;
+  std::size_t budget;
+  bool uploaded_anything = false;
+};
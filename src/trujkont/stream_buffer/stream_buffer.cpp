@@ -0,0 +1,111 @@
+#include <stdexcept>
+
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+
+#include "trujkont/gl_state/gl_state.hpp"
+
+#include <fmt/format.h>
+
+namespace
+{
+
+auto align_up(std::size_t const value, std::size_t const alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+StreamBuffer::StreamBuffer(GLsizeiptr const region_size, std::size_t const regions)
+  : region_size(align_up(static_cast<std::size_t>(region_size), region_alignment)),
+    fences(regions, nullptr)
+{
+  if(GLAD_GL_ARB_buffer_storage == 0) {
+    throw std::runtime_error("Streaming buffers require GL_ARB_buffer_storage, which this driver does not expose!");
+  }
+
+  auto const flags = GLbitfield(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+  auto const total_size = static_cast<GLsizeiptr>(this->region_size * regions);
+
+  glGenBuffers(1, &buffer);
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, buffer);
+  glBufferStorage(GL_COPY_WRITE_BUFFER, total_size, nullptr, flags);
+
+  mapped = static_cast<std::byte*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total_size, flags));
+
+  if(not mapped) {
+    throw std::runtime_error(fmt::format("Cannot persistently map a streaming buffer of {} bytes!", total_size));
+  }
+
+  allocation = gpu_memory::track(gpu_memory::Category::Buffer, static_cast<std::size_t>(total_size), "stream buffer");
+}
+
+StreamBuffer::~StreamBuffer()
+{
+  for(auto* const fence : fences) {
+    if(fence) glDeleteSync(fence);
+  }
+
+  gl_state::bind_buffer(GL_COPY_WRITE_BUFFER, buffer);
+  glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+
+  gl_state::forget_buffer(buffer);
+  glDeleteBuffers(1, &buffer);
+
+  gpu_memory::release(allocation);
+}
+
+auto StreamBuffer::begin_frame() -> void
+{
+  head = 0;
+
+  auto& fence = fences[region];
+  if(not fence) return;
+
+  auto constexpr one_second = GLuint64(1'000'000'000);
+
+  auto result = glClientWaitSync(fence, 0, 0);
+
+  if(result == GL_TIMEOUT_EXPIRED) {
+    ++stalls_count;
+
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, one_second);
+    } while(result == GL_TIMEOUT_EXPIRED);
+  }
+
+  if(result == GL_WAIT_FAILED) {
+    throw std::runtime_error("Waiting for a streaming buffer region failed!");
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+auto StreamBuffer::end_frame() -> void
+{
+  fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  region = (region + 1) % fences.size();
+}
+
+auto StreamBuffer::id() const noexcept -> GLuint
+{
+  return buffer;
+}
+
+auto StreamBuffer::stalls() const noexcept -> std::uint64_t
+{
+  return stalls_count;
+}
+
+auto StreamBuffer::allocate_bytes(std::size_t const size, std::size_t const alignment) -> tl::optional<std::size_t>
+{
+  auto const start = align_up(head, alignment);
+
+  if(start + size > region_size) return tl::nullopt;
+
+  head = start + size;
+
+  return region * region_size + start;
+}
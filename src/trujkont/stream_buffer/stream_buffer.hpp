@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <tl/optional.hpp>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+
+template<typename T>
+struct StreamAllocation
+{
+  std::span<T> data;
+  GLintptr offset = 0;
+
+  [[nodiscard]] auto size_bytes() const noexcept -> GLsizeiptr
+  {
+    return static_cast<GLsizeiptr>(data.size_bytes());
+  }
+};
+
+// Ring of `regions` equally sized slices of one persistently and coherently mapped buffer.
+// Every frame gets its own slice and writes into it with plain stores, while the GPU may still be reading the previous ones.
+// A fence placed at the end of the frame guards each slice, so we only ever wait when the CPU gets `regions` frames ahead,
+// and the driver never has to synchronize or orphan anything on our behalf.
+//
+// Usage per frame: `begin_frame()`, any number of `allocate()` + writes + draws sourcing the allocations, `end_frame()`.
+class StreamBuffer
+{
+public:
+  explicit StreamBuffer(GLsizeiptr region_size, std::size_t regions = default_regions);
+
+  StreamBuffer(StreamBuffer const&) = delete;
+  StreamBuffer(StreamBuffer&&) = delete;
+  auto operator=(StreamBuffer const&) -> StreamBuffer& = delete;
+  auto operator=(StreamBuffer&&) -> StreamBuffer& = delete;
+
+  ~StreamBuffer();
+
+  auto begin_frame() -> void;
+  auto end_frame() -> void;
+
+  // Returns nothing when the current frame's region has no more room left.
+  template<typename T>
+  [[nodiscard]] auto allocate(std::size_t const count, std::size_t const alignment = alignof(T)) -> tl::optional<StreamAllocation<T>>
+  {
+    auto const offset = allocate_bytes(count * sizeof(T), alignment);
+    if(not offset) return tl::nullopt;
+
+    return StreamAllocation<T> {
+      .data = std::span<T>(reinterpret_cast<T*>(mapped + *offset), count), // NOLINT
+      .offset = static_cast<GLintptr>(*offset)
+    };
+  }
+
+  [[nodiscard]] auto id() const noexcept -> GLuint;
+
+  // How many times `begin_frame` actually had to wait for the GPU.
+  [[nodiscard]] auto stalls() const noexcept -> std::uint64_t;
+
+  auto inline static constexpr default_regions = std::size_t(3);
+
+private:
+  [[nodiscard]] auto allocate_bytes(std::size_t size, std::size_t alignment) -> tl::optional<std::size_t>;
+
+  GLuint buffer = 0;
+  std::byte* mapped = nullptr;
+
+  gpu_memory::AllocationId allocation = 0;
+
+  std::size_t region_size = 0;
+  std::size_t region = 0;
+  std::size_t head = 0;
+
+  std::vector<GLsync> fences;
+
+  std::uint64_t stalls_count = 0;
+
+  // Covers every buffer offset alignment GL implementations ask for in practice.
+  auto inline static constexpr region_alignment = std::size_t(256);
+};
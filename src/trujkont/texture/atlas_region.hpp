@@ -0,0 +1,10 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Part of a `TextureAtlas` one of its images ended up in, in texture coordinates. The default covers the whole texture.
+struct AtlasRegion
+{
+  glm::vec2 uv_min = glm::vec2(0.);
+  glm::vec2 uv_max = glm::vec2(1.);
+};
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <limits>
+
+#include "trujkont/texture/rect_packer.hpp"
+
+RectPacker::RectPacker(int const width, int const height)
+  : atlas_width(width),
+    atlas_height(height),
+    skyline { Segment { .x = 0, .y = 0, .width = width } }
+{}
+
+auto RectPacker::pack(int const width, int const height) -> tl::optional<PackedRect>
+{
+  if(width <= 0 or height <= 0) return tl::nullopt;
+
+  auto best_segment = skyline.size();
+  auto best_top = std::numeric_limits<int>::max();
+  auto best_width = std::numeric_limits<int>::max();
+
+  for(auto i = std::size_t(0); i < skyline.size(); ++i) {
+    auto const y = fit(i, width, height);
+    if(not y) continue;
+
+    // Lowest top edge first, then the narrowest segment, to leave the wide ones for wide rectangles.
+    auto const top = *y + height;
+    if(top < best_top or (top == best_top and skyline[i].width < best_width)) {
+      best_segment = i;
+      best_top = top;
+      best_width = skyline[i].width;
+    }
+  }
+
+  if(best_segment == skyline.size()) return tl::nullopt;
+
+  auto const rect = PackedRect {
+    .x = skyline[best_segment].x,
+    .y = best_top - height,
+    .width = width,
+    .height = height,
+  };
+
+  place(best_segment, rect);
+
+  return rect;
+}
+
+auto RectPacker::width() const noexcept -> int
+{
+  return atlas_width;
+}
+
+auto RectPacker::height() const noexcept -> int
+{
+  return atlas_height;
+}
+
+auto RectPacker::fit(std::size_t const first, int const width, int const height) const -> tl::optional<int>
+{
+  auto const x = skyline[first].x;
+  if(x + width > atlas_width) return tl::nullopt;
+
+  // The rectangle has to rest on the highest of the segments it spans.
+  auto y = 0;
+  auto width_left = width;
+
+  for(auto i = first; width_left > 0; ++i) {
+    y = std::max(y, skyline[i].y);
+    if(y + height > atlas_height) return tl::nullopt;
+
+    width_left -= skyline[i].width;
+  }
+
+  return y;
+}
+
+auto RectPacker::place(std::size_t const first, PackedRect const& rect) -> void
+{
+  skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(first), Segment { .x = rect.x, .y = rect.y + rect.height, .width = rect.width });
+
+  // Whatever the new segment covers is shadowed by it, segments reaching past its end are trimmed.
+  auto const right = rect.x + rect.width;
+  auto next = first + 1;
+
+  while(next < skyline.size() and skyline[next].x < right) {
+    auto& segment = skyline[next];
+    auto const segment_right = segment.x + segment.width;
+
+    if(segment_right <= right) {
+      skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(next));
+      continue;
+    }
+
+    segment.width = segment_right - right;
+    segment.x = right;
+    break;
+  }
+
+  // Neighbours of the same height are one segment really, merging them keeps the list (and every search) short.
+  for(auto i = std::size_t(0); i + 1 < skyline.size();) {
+    if(skyline[i].y != skyline[i + 1].y) {
+      ++i;
+      continue;
+    }
+
+    skyline[i].width += skyline[i + 1].width;
+    skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include <tl/optional.hpp>
+
+struct PackedRect
+{
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+// Skyline bottom-left packing: remembers the top outline of everything placed so far as a list of horizontal segments,
+// and puts every new rectangle wherever along it its top edge ends up lowest. Rectangles are never rotated.
+// Packs best when fed the tallest rectangles first.
+class RectPacker
+{
+public:
+  RectPacker(int width, int height);
+
+  // Empty when there is no room left for it.
+  [[nodiscard]] auto pack(int width, int height) -> tl::optional<PackedRect>;
+
+  [[nodiscard]] auto width() const noexcept -> int;
+  [[nodiscard]] auto height() const noexcept -> int;
+
+private:
+  struct Segment
+  {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+  };
+
+  // Lowest y at which a rectangle of `width` could start at segment `first`, if it fits at all.
+  [[nodiscard]] auto fit(std::size_t first, int width, int height) const -> tl::optional<int>;
+
+  auto place(std::size_t first, PackedRect const& rect) -> void;
+
+  int atlas_width;
+  int atlas_height;
+
+  std::vector<Segment> skyline;
+};
@@ -1,30 +1,111 @@
+#include <vector>
+#include <span>
+
 #include "trujkont/texture/texture.hpp"
 
 #include <fmt/format.h>
 
 #include <glad/glad.h>
 
+#include "trujkont/asset_pack/asset_pack.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/mipmaps/mip_cache.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
+#include "trujkont/pixels/pixels.hpp"
+
 #include "stb/stb_image.h"
 
-Texture::Texture(TextureFormat const format) noexcept
+auto next_texture_slot() noexcept -> TextureSlot
 {
-  basic_info.format = format;
+  auto static current_slot_nr = TextureSlot(0);
+
+  return current_slot_nr++;
+}
+
+auto compressed_format_supported(BlockFormat const format) -> bool
+{
+  return format == BlockFormat::Bc7 ? GLAD_GL_ARB_texture_compression_bptc != 0 : GLAD_GL_EXT_texture_compression_s3tc != 0;
+}
+
+auto gl_compressed_format(BlockFormat const format) -> GLenum
+{
+  switch(format) {
+    case BlockFormat::Bc1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case BlockFormat::Bc3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case BlockFormat::Bc7: return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+  }
+
+  return GL_NONE;
+}
+
+auto load_image(std::filesystem::path const& path, int* const width, int* const height, int* const channels_number, int const desired_channels)
+  -> unsigned char*
+{
+  if(auto const packed = assets::find(path)) {
+    return stbi_load_from_memory(
+      reinterpret_cast<stbi_uc const*>(packed->data()), // NOLINT
+      static_cast<int>(packed->size()),
+      width,
+      height,
+      channels_number,
+      desired_channels
+    );
+  }
 
-  auto static current_slot_nr = 0;
-  basic_info.slot = current_slot_nr;
+  return stbi_load(path.c_str(), width, height, channels_number, desired_channels);
+}
 
-  current_slot_nr++;
+auto texture_mip_settings(TextureFormat const format) -> MipSettings
+{
+  return MipSettings {
+    .filter = MipFilter::Kaiser,
+    .srgb = true,
+    .opaque = format == TextureFormat::RGB,
+    .alpha_reference = tl::nullopt,
+  };
+}
+
+Texture::Texture(TextureFormat const format) noexcept
+{
+  basic_info.format = format;
+  basic_info.slot = next_texture_slot();
 }
 
 Texture::Texture(std::filesystem::path const& texture_path, TextureFormat const format)
   : Texture(format)
 {
-  auto* const data = stbi_load(
-    texture_path.c_str(),
+  if(texture_path.extension() == compressed_texture_extension) {
+    // From a pack the blocks go to GL straight from its mapped pages, a loose file has to be read in first.
+    if(auto const packed = assets::find(texture_path)) {
+      auto const compressed = parse_compressed_texture(*packed);
+      if(not compressed) throw std::runtime_error(fmt::format("\"{}\": {}", texture_path.c_str(), compressed.error()));
+
+      upload(*compressed, texture_path.string());
+      return;
+    }
+
+    auto const compressed = read_compressed_texture(texture_path);
+    if(not compressed) throw std::runtime_error(compressed.error());
+
+    upload(compressed->view, texture_path.string());
+    return;
+  }
+
+  if(auto const levels = read_mip_cache(texture_path, texture_mip_settings(format))) {
+    basic_info.channels_number = 4;
+
+    upload(*levels, texture_path.string());
+    return;
+  }
+
+  auto const channels = format == TextureFormat::RGBA ? 4 : 3;
+
+  auto* const data = load_image(
+    texture_path,
     &basic_info.width,
     &basic_info.height,
     &basic_info.channels_number,
-    0
+    channels
   );
 
   if(not data) {
@@ -35,17 +116,107 @@ Texture::Texture(std::filesystem::path const& texture_path, TextureFormat const
 
   glGenTextures(1, &basic_info.id);
 
-  glActiveTexture(GL_TEXTURE0 + basic_info.slot);
-  glBindTexture(GL_TEXTURE_2D, basic_info.id);
+  gl_state::active_texture(basic_info.slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, basic_info.id);
 
+  auto const pixels_count = static_cast<std::size_t>(basic_info.width) * static_cast<std::size_t>(basic_info.height);
   auto const gl_format = static_cast<GLuint>(format);
-  glTexImage2D(GL_TEXTURE_2D, 0, gl_format, basic_info.width, basic_info.height, 0, gl_format, GL_UNSIGNED_BYTE, data);
+
+  // Handed to GL as RGBA, RGB rows would have the driver pad and convert every pixel inside `glTexImage2D`.
+  // Expanded right here on the GL thread, there's no job system to hand it to; `TextureLoader` expands on its jobs.
+  if(format == TextureFormat::RGB) {
+    auto rgba = std::vector<std::byte>(pixels_count * 4);
+    expand_rgb(std::span(reinterpret_cast<std::byte const*>(data), pixels_count * 3), rgba); // NOLINT
+
+    glTexImage2D(GL_TEXTURE_2D, 0, gl_format, basic_info.width, basic_info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, gl_format, basic_info.width, basic_info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  }
+
   glGenerateMipmap(GL_TEXTURE_2D);
 
   stbi_image_free(data);
+
+  auto const size = pixels_count * stored_texel_size;
+
+  gpu_memory::track(gpu_memory::Category::Texture, gpu_memory::with_mips(size), texture_path.string());
+}
+
+Texture::Texture(CompressedTextureView const& compressed)
+  : Texture(TextureFormat::RGBA)
+{
+  upload(compressed, fmt::format("{} texture {}x{}", block_format_name(compressed.format), compressed.width, compressed.height));
 }
 
 auto Texture::get_slot() const noexcept -> TextureSlot
 {
   return basic_info.slot;
 }
+
+auto Texture::upload(CompressedTextureView const& compressed, std::string label) -> void
+{
+  basic_info.width = compressed.width;
+  basic_info.height = compressed.height;
+  basic_info.channels_number = 4;
+
+  glGenTextures(1, &basic_info.id);
+
+  gl_state::active_texture(basic_info.slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, basic_info.id);
+
+  auto const supported = compressed_format_supported(compressed.format);
+  auto size = std::size_t(0);
+
+  for(auto level = std::size_t(0); level < compressed.mips.size(); ++level) {
+    auto const& mip = compressed.mips[level];
+    auto const gl_level = static_cast<GLint>(level);
+
+    if(supported) {
+      glCompressedTexImage2D(
+        GL_TEXTURE_2D,
+        gl_level,
+        gl_compressed_format(compressed.format),
+        mip.width,
+        mip.height,
+        0,
+        static_cast<GLsizei>(mip.blocks.size()),
+        mip.blocks.data()
+      );
+
+      size += mip.blocks.size();
+    } else {
+      auto const pixels = decode_blocks(mip.blocks, mip.width, mip.height, compressed.format);
+      glTexImage2D(GL_TEXTURE_2D, gl_level, GL_RGBA, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+      size += pixels.size();
+    }
+  }
+
+  // The chain may stop before 1x1, the texture would be incomplete (and sample black) if GL kept expecting the rest.
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(compressed.mips.size()) - 1);
+
+  gpu_memory::track(gpu_memory::Category::Texture, size, std::move(label));
+}
+
+auto Texture::upload(std::span<MipLevel const> const levels, std::string label) -> void
+{
+  basic_info.width = levels.front().width;
+  basic_info.height = levels.front().height;
+
+  glGenTextures(1, &basic_info.id);
+
+  gl_state::active_texture(basic_info.slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, basic_info.id);
+
+  auto const gl_format = static_cast<GLuint>(basic_info.format);
+  auto size = std::size_t(0);
+
+  for(auto level = std::size_t(0); level < levels.size(); ++level) {
+    auto const& mip = levels[level];
+    glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), gl_format, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, mip.pixels.data());
+
+    size += static_cast<std::size_t>(mip.width) * static_cast<std::size_t>(mip.height) * stored_texel_size;
+  }
+
+  gpu_memory::track(gpu_memory::Category::Texture, size, std::move(label));
+}
@@ -1,17 +1,40 @@
 #pragma once
 
 #include <filesystem>
+#include <cstddef>
+#include <string>
+#include <span>
 
 #include <glad/glad.h>
 
+#include "trujkont/block_compression/compressed_texture.hpp"
+#include "trujkont/mipmaps/mip_chain.hpp"
+
 using TextureSlot = unsigned int;
 
+// Every texture gets a unit of its own for the life of the process.
+[[nodiscard]] auto next_texture_slot() noexcept -> TextureSlot;
+
+// Whether the driver samples `format` itself, textures in the others are uploaded decoded to RGBA.
+[[nodiscard]] auto compressed_format_supported(BlockFormat format) -> bool;
+
+[[nodiscard]] auto gl_compressed_format(BlockFormat format) -> GLenum;
+
+// `stbi_load`, decoding straight from the mounted asset pack's pages when it has `path`. Free with `stbi_image_free`.
+[[nodiscard]] auto load_image(std::filesystem::path const& path, int* width, int* height, int* channels_number, int desired_channels) -> unsigned char*;
+
 enum class TextureFormat : GLuint
 {
   RGB = GL_RGB,
   RGBA = GL_RGBA,
 };
 
+// What GL actually keeps per texel of either format, drivers pad RGB to 4 bytes just like RGBA. For `gpu_memory`.
+auto inline constexpr stored_texel_size = std::size_t(4);
+
+// What images loaded as textures of `format` get their mip chains generated, and cached, with.
+[[nodiscard]] auto texture_mip_settings(TextureFormat format) -> MipSettings;
+
 struct TextureBasicInfo
 {
   TextureFormat format = TextureFormat::RGB;
@@ -28,10 +51,19 @@ class Texture
 {
 public:
   Texture(TextureFormat const format = TextureFormat::RGB) noexcept;
+  // Baked `.tbc` files are uploaded as they are, `format` only applies to images decoded here.
+  // Images with a cached mip chain (see `load_mip_chain`) are uploaded from it, the rest get theirs from `glGenerateMipmap`.
   Texture(std::filesystem::path const& texture_path, TextureFormat const format = TextureFormat::RGB);
 
+  // Straight from the blocks with `glCompressedTexImage2D`, mips included. Drivers without the format get them decoded on the CPU.
+  explicit Texture(CompressedTextureView const& compressed);
+
   auto get_slot() const noexcept -> TextureSlot;
 
 private:
+  auto upload(CompressedTextureView const& compressed, std::string label) -> void;
+
+  auto upload(std::span<MipLevel const> levels, std::string label) -> void;
+
   TextureBasicInfo basic_info;
 };
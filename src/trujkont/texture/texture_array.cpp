@@ -0,0 +1,94 @@
+#include <stdexcept>
+
+#include "trujkont/texture/texture_array.hpp"
+
+#include <fmt/format.h>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
+
+TextureArray::TextureArray(GLsizei const width, GLsizei const height, TextureFormat const format, GLsizei const capacity)
+  : slot(next_texture_slot()),
+    layers_width(width),
+    layers_height(height),
+    layers_format(format),
+    layers_capacity(capacity)
+{
+  if(capacity <= 0) {
+    throw std::invalid_argument("A texture array needs at least one layer.");
+  }
+
+  glGenTextures(1, &id);
+
+  gl_state::active_texture(slot);
+  gl_state::bind_texture(GL_TEXTURE_2D_ARRAY, id);
+
+  auto const gl_format = static_cast<GLuint>(format);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, gl_format, width, height, capacity, 0, gl_format, GL_UNSIGNED_BYTE, nullptr);
+
+  auto const layers_size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(capacity) * stored_texel_size;
+
+  allocation = gpu_memory::track(gpu_memory::Category::Texture, gpu_memory::with_mips(layers_size), fmt::format("texture array {}x{}x{}", width, height, capacity));
+}
+
+TextureArray::~TextureArray()
+{
+  gpu_memory::release(allocation);
+
+  gl_state::forget_texture(id);
+  glDeleteTextures(1, &id);
+}
+
+auto TextureArray::upload(GLsizei const layer, std::span<std::byte const> const pixels) -> void
+{
+  auto const expected_size = static_cast<std::size_t>(layers_width) * static_cast<std::size_t>(layers_height) * 4;
+
+  if(layer < 0 or layer >= layers_capacity or pixels.size() != expected_size) {
+    throw std::invalid_argument(fmt::format(
+      "Layer {} of {} bytes does not fit a {}x{} array of {} layers.",
+      layer,
+      pixels.size(),
+      layers_width,
+      layers_height,
+      layers_capacity
+    ));
+  }
+
+  gl_state::active_texture(slot);
+  gl_state::bind_texture(GL_TEXTURE_2D_ARRAY, id);
+
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, layers_width, layers_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+}
+
+auto TextureArray::generate_mipmaps() -> void
+{
+  gl_state::active_texture(slot);
+  gl_state::bind_texture(GL_TEXTURE_2D_ARRAY, id);
+
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+}
+
+auto TextureArray::get_slot() const noexcept -> TextureSlot
+{
+  return slot;
+}
+
+auto TextureArray::capacity() const noexcept -> GLsizei
+{
+  return layers_capacity;
+}
+
+auto TextureArray::width() const noexcept -> GLsizei
+{
+  return layers_width;
+}
+
+auto TextureArray::height() const noexcept -> GLsizei
+{
+  return layers_height;
+}
+
+auto TextureArray::format() const noexcept -> TextureFormat
+{
+  return layers_format;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <glad/glad.h>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/texture/texture.hpp"
+
+// `capacity` same sized, same format images as the layers of one `GL_TEXTURE_2D_ARRAY`,
+// so draws can pick an image per instance without any binding changes.
+class TextureArray
+{
+public:
+  TextureArray(GLsizei width, GLsizei height, TextureFormat format, GLsizei capacity);
+
+  TextureArray(TextureArray const&) = delete;
+  TextureArray(TextureArray&&) = delete;
+  auto operator=(TextureArray const&) -> TextureArray& = delete;
+  auto operator=(TextureArray&&) -> TextureArray& = delete;
+
+  ~TextureArray();
+
+  // `pixels` are tightly packed RGBA rows of the array's size, whatever its format, which GL takes without converting.
+  auto upload(GLsizei layer, std::span<std::byte const> pixels) -> void;
+
+  // Has to be called after uploading, before the layers are sampled.
+  auto generate_mipmaps() -> void;
+
+  [[nodiscard]] auto get_slot() const noexcept -> TextureSlot;
+
+  [[nodiscard]] auto capacity() const noexcept -> GLsizei;
+
+  [[nodiscard]] auto width() const noexcept -> GLsizei;
+  [[nodiscard]] auto height() const noexcept -> GLsizei;
+  [[nodiscard]] auto format() const noexcept -> TextureFormat;
+
+private:
+  TextureSlot slot = 0;
+  GLuint id = 0;
+
+  gpu_memory::AllocationId allocation = 0;
+
+  GLsizei layers_width = 0;
+  GLsizei layers_height = 0;
+  TextureFormat layers_format = TextureFormat::RGB;
+  GLsizei layers_capacity = 0;
+};
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include <vector>
+
+#include "trujkont/texture/texture_array_pool.hpp"
+
+#include <fmt/format.h>
+
+#include "trujkont/pixels/pixels.hpp"
+
+#include "stb/stb_image.h"
+
+TextureArrayPool::TextureArrayPool(GLsizei const layers_per_array)
+  : layers_per_array(layers_per_array)
+{}
+
+TextureArrayPool::PooledArray::PooledArray(GLsizei const width, GLsizei const height, TextureFormat const format, GLsizei const capacity)
+  : array(width, height, format, capacity)
+{}
+
+auto TextureArrayPool::add(std::filesystem::path const& path, TextureFormat const format) -> TextureLayer
+{
+  auto const channels = format == TextureFormat::RGBA ? 4 : 3;
+
+  auto width = 0;
+  auto height = 0;
+  auto channels_number = 0;
+
+  auto const data = std::unique_ptr<stbi_uc, decltype(&stbi_image_free)>(
+    load_image(path, &width, &height, &channels_number, channels),
+    &stbi_image_free
+  );
+
+  if(not data) {
+    throw std::runtime_error(fmt::format("Cannot find texture @ \"{}\".", path.c_str()));
+  }
+
+  auto const pixels_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  auto const pixels = std::span(reinterpret_cast<std::byte*>(data.get()), pixels_count * static_cast<std::size_t>(channels)); // NOLINT
+
+  if(format == TextureFormat::RGBA) {
+    premultiply_alpha(pixels);
+    return add(pixels, width, height, format);
+  }
+
+  // Handed to GL as RGBA, like every other upload, RGB rows would have the driver pad and convert every pixel.
+  auto rgba = std::vector<std::byte>(pixels_count * 4);
+  expand_rgb(pixels, rgba);
+
+  return add(rgba, width, height, format);
+}
+
+auto TextureArrayPool::add(std::span<std::byte const> const pixels, GLsizei const width, GLsizei const height, TextureFormat const format)
+  -> TextureLayer
+{
+  auto pooled = std::ranges::find_if(arrays, [&](PooledArray const& candidate) {
+    auto const& array = candidate.array;
+
+    return array.width() == width and array.height() == height and array.format() == format and candidate.used < array.capacity();
+  });
+
+  if(pooled == arrays.end()) {
+    arrays.emplace_back(width, height, format, layers_per_array);
+    pooled = std::prev(arrays.end());
+  }
+
+  auto const layer = pooled->used;
+  pooled->array.upload(layer, pixels);
+
+  ++pooled->used;
+  pooled->dirty = true;
+
+  return TextureLayer { .slot = pooled->array.get_slot(), .layer = static_cast<std::uint32_t>(layer) };
+}
+
+auto TextureArrayPool::update() -> void
+{
+  for(auto& pooled : arrays) {
+    if(not pooled.dirty) continue;
+
+    pooled.array.generate_mipmaps();
+    pooled.dirty = false;
+  }
+}
+
+auto TextureArrayPool::arrays_count() const noexcept -> std::size_t
+{
+  return arrays.size();
+}
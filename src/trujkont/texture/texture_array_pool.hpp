@@ -0,0 +1,54 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <span>
+
+#include "trujkont/texture/texture_array.hpp"
+
+// Where a pooled image ended up: the unit of its array and its layer in it.
+struct TextureLayer
+{
+  TextureSlot slot = 0;
+  std::uint32_t layer = 0;
+};
+
+// Sorts images into texture arrays by size and format, so everything of one kind shares a single unit
+// instead of taking one each, and instanced draws can pick their image with a per instance layer.
+// An array that fills up is followed by a new one of the same kind, never resized.
+class TextureArrayPool
+{
+public:
+  auto inline static constexpr default_layers_per_array = GLsizei(16);
+
+  explicit TextureArrayPool(GLsizei layers_per_array = default_layers_per_array);
+
+  // Throws when the image cannot be loaded, like `Texture` does.
+  // RGBA images are stored with premultiplied alpha, to be blended with `GL_ONE, GL_ONE_MINUS_SRC_ALPHA`.
+  [[nodiscard]] auto add(std::filesystem::path const& path, TextureFormat format = TextureFormat::RGB) -> TextureLayer;
+
+  // `pixels` are tightly packed RGBA rows of `width` by `height` pixels, stored as they are in `format` (RGB drops the alpha).
+  [[nodiscard]] auto add(std::span<std::byte const> pixels, GLsizei width, GLsizei height, TextureFormat format) -> TextureLayer;
+
+  // Regenerates the mipmaps of the arrays that got new layers since the last call, once per array however many were added.
+  auto update() -> void;
+
+  [[nodiscard]] auto arrays_count() const noexcept -> std::size_t;
+
+private:
+  struct PooledArray
+  {
+    PooledArray(GLsizei width, GLsizei height, TextureFormat format, GLsizei capacity);
+
+    TextureArray array;
+    GLsizei used = 0;
+    bool dirty = false;
+  };
+
+  GLsizei layers_per_array;
+
+  // Arrays own their GL texture and can't move, a deque never moves what it already holds.
+  std::deque<PooledArray> arrays;
+};
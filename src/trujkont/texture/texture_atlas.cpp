@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <stdexcept>
+#include <numeric>
+#include <cstring>
+#include <memory>
+
+#include "trujkont/texture/texture_atlas.hpp"
+
+#include <fmt/format.h>
+
+#include "trujkont/texture/rect_packer.hpp"
+#include "trujkont/pixels/pixels.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
+
+#include "stb/stb_image.h"
+
+namespace
+{
+
+auto constexpr channels = 4;
+
+struct Image
+{
+  std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels = { nullptr, &stbi_image_free };
+  int width = 0;
+  int height = 0;
+};
+
+// Of a full mip chain of a `size` wide texture, down to 1x1.
+auto size_levels(int size) -> int
+{
+  auto levels = 1;
+  for(; size > 1; size /= 2) ++levels;
+
+  return levels;
+}
+
+// Fills `cell` of `canvas` with `image`, `padding` pixels in from its top left corner, and everything around it with
+// copies of the image's nearest edge pixel.
+auto blit_padded(std::vector<std::uint8_t>& canvas, int const canvas_size, Image const& image, PackedRect const& cell, int const padding) -> void
+{
+  for(auto row = 0; row < cell.height; ++row) {
+    auto const source_row = std::clamp(row - padding, 0, image.height - 1);
+
+    for(auto column = 0; column < cell.width; ++column) {
+      auto const source_column = std::clamp(column - padding, 0, image.width - 1);
+
+      auto const source = (static_cast<std::size_t>(source_row) * image.width + source_column) * channels;
+      auto const destination = (static_cast<std::size_t>(cell.y + row) * canvas_size + (cell.x + column)) * channels;
+
+      std::memcpy(canvas.data() + destination, image.pixels.get() + source, channels);
+    }
+  }
+}
+
+// The cell of each of `images` in a `size` wide atlas, or nothing if they don't all fit. Cells are `block` aligned and
+// sized, they're packed in whole blocks.
+auto pack_images(std::span<Image const> const images, std::span<std::size_t const> const order, int const size, int const block)
+  -> tl::optional<std::vector<PackedRect>>
+{
+  auto const blocks = [block](int const pixels) { return (pixels + block - 1) / block; };
+
+  auto packer = RectPacker(size / block, size / block);
+  auto cells = std::vector<PackedRect>(images.size());
+
+  for(auto const i : order) {
+    // The padding is a block on every side.
+    auto const rect = packer.pack(blocks(images[i].width) + 2, blocks(images[i].height) + 2);
+    if(not rect) return tl::nullopt;
+
+    cells[i] = PackedRect { .x = rect->x * block, .y = rect->y * block, .width = rect->width * block, .height = rect->height * block };
+  }
+
+  return cells;
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas(std::span<std::filesystem::path const> const paths, int const size, int const levels)
+  : slot(next_texture_slot()),
+    atlas_size(size),
+    regions(paths.size())
+{
+  if(levels < 1 or levels > size_levels(size)) {
+    throw std::invalid_argument(fmt::format("A {} wide atlas cannot have {} mip levels.", size, levels));
+  }
+
+  // A texel of the last mip covers a block of the first, every cell spans whole blocks of its own.
+  auto const block = 1 << (levels - 1);
+
+  auto images = std::vector<Image>(paths.size());
+
+  for(auto i = std::size_t(0); i < paths.size(); ++i) {
+    auto channels_number = 0;
+    auto& image = images[i];
+
+    image.pixels.reset(load_image(paths[i], &image.width, &image.height, &channels_number, channels));
+
+    if(not image.pixels) {
+      throw std::runtime_error(fmt::format("Cannot find texture @ \"{}\".", paths[i].c_str()));
+    }
+  }
+
+  // The packer does best with the tallest images first.
+  auto order = std::vector<std::size_t>(images.size());
+  std::iota(order.begin(), order.end(), std::size_t(0));
+  std::ranges::stable_sort(order, std::ranges::greater(), [&images](std::size_t const i) { return images[i].height; });
+
+  auto max_size = GLint(0);
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+
+  auto cells = pack_images(images, order, atlas_size, block);
+
+  while(not cells and atlas_size < max_size) {
+    atlas_size = std::min(atlas_size * 2, static_cast<int>(max_size));
+    cells = pack_images(images, order, atlas_size, block);
+  }
+
+  if(not cells) {
+    throw std::runtime_error(fmt::format("{} textures do not fit into a {}x{} atlas.", paths.size(), atlas_size, atlas_size));
+  }
+
+  auto canvas = std::vector<std::uint8_t>(static_cast<std::size_t>(atlas_size) * atlas_size * channels);
+  auto const texel = 1.0F / static_cast<float>(atlas_size);
+
+  for(auto i = std::size_t(0); i < images.size(); ++i) {
+    auto const& image = images[i];
+
+    auto const& cell = (*cells)[i];
+    blit_padded(canvas, atlas_size, image, cell, block);
+
+    auto const x = cell.x + block;
+    auto const y = cell.y + block;
+
+    regions[i] = AtlasRegion {
+      .uv_min = glm::vec2(static_cast<float>(x), static_cast<float>(y)) * texel,
+      .uv_max = glm::vec2(static_cast<float>(x + image.width), static_cast<float>(y + image.height)) * texel,
+    };
+  }
+
+  // Blended like the pooled arrays it's drawn along with.
+  premultiply_alpha(std::as_writable_bytes(std::span(canvas)));
+
+  glGenTextures(1, &id);
+
+  gl_state::active_texture(slot);
+  gl_state::bind_texture(GL_TEXTURE_2D_ARRAY, id);
+
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, atlas_size, atlas_size, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, canvas.data());
+
+  // Set first, so the coarser mips that would blend neighbouring cells are never generated, let alone sampled.
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+  allocation = gpu_memory::track(gpu_memory::Category::Texture, gpu_memory::with_mips(canvas.size()), fmt::format("texture atlas {}x{}", atlas_size, atlas_size));
+}
+
+TextureAtlas::~TextureAtlas()
+{
+  gpu_memory::release(allocation);
+
+  gl_state::forget_texture(id);
+  glDeleteTextures(1, &id);
+}
+
+auto TextureAtlas::region(std::size_t const index) const -> AtlasRegion
+{
+  return regions.at(index);
+}
+
+auto TextureAtlas::get_slot() const noexcept -> TextureSlot
+{
+  return slot;
+}
+
+auto TextureAtlas::size() const noexcept -> int
+{
+  return atlas_size;
+}
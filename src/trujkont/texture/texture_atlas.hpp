@@ -0,0 +1,57 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+#include <glad/glad.h>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/texture/atlas_region.hpp"
+#include "trujkont/texture/texture.hpp"
+
+// Many small RGBA images (sprites, icons) packed with a `RectPacker` into one square texture, so they all share a single unit
+// and instanced draws pick theirs with nothing but a per instance `AtlasRegion`.
+// Every image gets a cell of its own, aligned to and a multiple of `1 << (levels - 1)` pixels, which it fills with
+// copies of its own edge pixels at least that far around it. Down to the last of its `levels` mips no texel then mixes
+// two cells and filtering never pulls in a neighbour; coarser mips, which would, are never generated or sampled.
+// The texture is the only layer of a `GL_TEXTURE_2D_ARRAY` with premultiplied alpha, so it's sampled exactly like
+// the arrays of a `TextureArrayPool`, e.g. by `BillboardBatch` at layer `layer`.
+class TextureAtlas
+{
+public:
+  auto inline static constexpr default_size = 1024;
+  auto inline static constexpr default_levels = 4;
+
+  auto inline static constexpr layer = std::uint32_t(0);
+
+  // Starts out `size` wide and doubles until the images fit. Throws when an image cannot be loaded,
+  // or they don't fit even the largest texture the driver supports.
+  explicit TextureAtlas(std::span<std::filesystem::path const> paths, int size = default_size, int levels = default_levels);
+
+  TextureAtlas(TextureAtlas const&) = delete;
+  TextureAtlas(TextureAtlas&&) = delete;
+  auto operator=(TextureAtlas const&) -> TextureAtlas& = delete;
+  auto operator=(TextureAtlas&&) -> TextureAtlas& = delete;
+
+  ~TextureAtlas();
+
+  // Of `paths[index]`.
+  [[nodiscard]] auto region(std::size_t index) const -> AtlasRegion;
+
+  [[nodiscard]] auto get_slot() const noexcept -> TextureSlot;
+
+  [[nodiscard]] auto size() const noexcept -> int;
+
+private:
+  TextureSlot slot = 0;
+  GLuint id = 0;
+
+  gpu_memory::AllocationId allocation = 0;
+
+  int atlas_size = 0;
+
+  std::vector<AtlasRegion> regions;
+};
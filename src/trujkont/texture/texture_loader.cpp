@@ -0,0 +1,175 @@
+#include <utility>
+#include <array>
+
+#include "trujkont/texture/texture_loader.hpp"
+
+#include <fmt/format.h>
+
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
+#include "trujkont/mipmaps/mip_cache.hpp"
+
+namespace
+{
+
+// Magenta and black checkers, unmistakable for anything that was meant to be there.
+auto create_placeholder() -> GLuint
+{
+  auto constexpr pixels = std::array<std::uint8_t, 16> {
+    255, 0, 255, 255, 0, 0, 0, 255,
+    0, 0, 0, 255, 255, 0, 255, 255
+  };
+
+  auto placeholder = GLuint(0);
+  glGenTextures(1, &placeholder);
+
+  gl_state::bind_texture(GL_TEXTURE_2D, placeholder);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+  // No mipmaps, so the default minification filter (which expects them) would make it incomplete.
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+  return placeholder;
+}
+
+} // namespace
+
+TextureLoader::TextureLoader(JobSystem& jobs, StreamBuffer& stream, std::size_t const upload_budget)
+  : jobs(jobs),
+    stream(stream),
+    upload_budget(upload_budget),
+    upload_unit(next_texture_slot())
+{
+  gl_state::active_texture(upload_unit);
+  placeholder = create_placeholder();
+}
+
+TextureLoader::~TextureLoader()
+{
+  jobs.wait(decoding);
+
+  for(auto const& upload : uploads) {
+    gl_state::forget_texture(upload.id);
+    glDeleteTextures(1, &upload.id);
+  }
+
+  gl_state::forget_texture(placeholder);
+  glDeleteTextures(1, &placeholder);
+}
+
+auto TextureLoader::load(std::filesystem::path path, TextureFormat const format) -> std::shared_ptr<AsyncTexture const>
+{
+  auto texture = std::make_shared<AsyncTexture>();
+  texture->slot = next_texture_slot();
+
+  gl_state::active_texture(texture->slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, placeholder);
+
+  ++decodes_pending;
+
+  jobs.submit(
+    [this, texture, path = std::move(path), format] {
+      auto image = DecodedImage { .texture = texture, .path = path, .format = format, .levels = {} };
+
+      // RGB images come out expanded to RGBA, which GL takes as it is.
+      if(auto levels = load_mip_chain(jobs, path, texture_mip_settings(format))) {
+        image.levels = *std::move(levels);
+      } else {
+        fmt::print(stderr, "{}\n", levels.error());
+      }
+
+      auto const lock = std::scoped_lock(decoded_mutex);
+      decoded.push_back(std::move(image));
+    },
+    &decoding
+  );
+
+  return texture;
+}
+
+auto TextureLoader::update() -> void
+{
+  {
+    auto const lock = std::scoped_lock(decoded_mutex);
+
+    decodes_pending -= decoded.size();
+
+    for(auto& image : decoded) {
+      if(image.levels.empty()) continue;
+
+      auto upload = Upload { .image = std::move(image), .id = 0, .level = 0, .rows_uploaded = 0 };
+
+      // A texture object of its own, so the placeholder stays in place until the image is complete.
+      glGenTextures(1, &upload.id);
+      gl_state::active_texture(upload_unit);
+      gl_state::bind_texture(GL_TEXTURE_2D, upload.id);
+
+      auto const gl_format = static_cast<GLuint>(upload.image.format);
+
+      for(auto level = std::size_t(0); level < upload.image.levels.size(); ++level) {
+        auto const& mip = upload.image.levels[level];
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), gl_format, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+      }
+
+      uploads.push_back(std::move(upload));
+    }
+
+    decoded.clear();
+  }
+
+  if(uploads.empty()) return;
+
+  auto frame = PixelUploadFrame(stream, upload_budget);
+
+  while(not uploads.empty() and upload_rows(uploads.front(), frame)) {
+    finish(uploads.front());
+    uploads.pop_front();
+  }
+}
+
+auto TextureLoader::pending() const noexcept -> std::size_t
+{
+  return decodes_pending + uploads.size();
+}
+
+auto TextureLoader::upload_rows(Upload& upload, PixelUploadFrame& frame) -> bool
+{
+  gl_state::active_texture(upload_unit);
+  gl_state::bind_texture(GL_TEXTURE_2D, upload.id);
+
+  while(upload.level < upload.image.levels.size()) {
+    auto const& image = upload.image.levels[upload.level];
+    auto const level = static_cast<GLint>(upload.level);
+
+    auto const uploaded = frame.upload_rows(image.pixels, static_cast<std::size_t>(image.width) * 4, image.height, upload.rows_uploaded, [&](StagedRows const& rows) {
+      glTexSubImage2D(GL_TEXTURE_2D, level, 0, rows.first_row, image.width, rows.rows, GL_RGBA, GL_UNSIGNED_BYTE, rows.pixels);
+    });
+
+    if(not uploaded) return false;
+
+    ++upload.level;
+    upload.rows_uploaded = 0;
+  }
+
+  return true;
+}
+
+auto TextureLoader::finish(Upload& upload) -> void
+{
+  auto& texture = *upload.image.texture;
+  texture.id = upload.id;
+  texture.is_ready = true;
+
+  gl_state::active_texture(texture.slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, texture.id);
+
+  auto const& image = upload.image;
+  auto size = std::size_t(0);
+
+  for(auto const& level : image.levels) {
+    size += static_cast<std::size_t>(level.width) * static_cast<std::size_t>(level.height) * stored_texel_size;
+  }
+
+  gpu_memory::track(gpu_memory::Category::Texture, size, image.path.string());
+}
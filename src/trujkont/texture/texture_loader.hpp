@@ -0,0 +1,103 @@
+#pragma once
+
+#include <filesystem>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include <glad/glad.h>
+
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+#include "trujkont/stream_buffer/pixel_upload.hpp"
+#include "trujkont/mipmaps/mip_chain.hpp"
+#include "trujkont/texture/texture.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+// A texture that may still be on its way. Its slot is valid right away, sampling it shows a placeholder
+// until the real image is uploaded, after which the same slot shows the image.
+class AsyncTexture
+{
+public:
+  [[nodiscard]] auto get_slot() const noexcept -> TextureSlot { return slot; }
+
+  [[nodiscard]] auto ready() const noexcept -> bool { return is_ready; }
+
+private:
+  friend class TextureLoader;
+
+  TextureSlot slot = 0;
+  GLuint id = 0;
+  bool is_ready = false;
+};
+
+// Loads images with their whole mip chain on the job system, from the chain's cache or decoding and generating it (see
+// `load_mip_chain`), and uploads every level through a `PixelUploadFrame`, at most `upload_budget` bytes per frame.
+// Nothing is left for `glGenerateMipmap` to do on the GL thread.
+//
+// Usage per frame: `update()` somewhere between the stream's `begin_frame()` and `end_frame()`.
+class TextureLoader
+{
+public:
+  auto inline static constexpr default_upload_budget = std::size_t(4 * 1024 * 1024);
+
+  TextureLoader(JobSystem& jobs, StreamBuffer& stream, std::size_t upload_budget = default_upload_budget);
+
+  TextureLoader(TextureLoader const&) = delete;
+  TextureLoader(TextureLoader&&) = delete;
+  auto operator=(TextureLoader const&) -> TextureLoader& = delete;
+  auto operator=(TextureLoader&&) -> TextureLoader& = delete;
+
+  // Waits for the decodes still in flight, they write into the loader.
+  ~TextureLoader();
+
+  // Failing to decode is only reported on stderr, the texture keeps showing the placeholder.
+  [[nodiscard]] auto load(std::filesystem::path path, TextureFormat format = TextureFormat::RGB) -> std::shared_ptr<AsyncTexture const>;
+
+  auto update() -> void;
+
+  // Decoding or uploading.
+  [[nodiscard]] auto pending() const noexcept -> std::size_t;
+
+private:
+  struct DecodedImage
+  {
+    std::shared_ptr<AsyncTexture> texture;
+    std::filesystem::path path;
+    TextureFormat format = TextureFormat::RGB;
+
+    // RGBA whatever the `format`, which is only the one the texture stores. Empty when loading failed.
+    std::vector<MipLevel> levels;
+  };
+
+  struct Upload
+  {
+    DecodedImage image;
+    GLuint id = 0;
+    std::size_t level = 0;
+    int rows_uploaded = 0;
+  };
+
+  // Returns false when the frame has no room left, the rest of the image is uploaded in the next ones.
+  auto upload_rows(Upload& upload, PixelUploadFrame& frame) -> bool;
+
+  auto finish(Upload& upload) -> void;
+
+  JobSystem& jobs;
+  StreamBuffer& stream;
+  std::size_t upload_budget;
+
+  // Textures being uploaded are bound here, every other unit belongs to a texture.
+  TextureSlot upload_unit = 0;
+  GLuint placeholder = 0;
+
+  JobCounter decoding;
+  std::size_t decodes_pending = 0;
+
+  std::mutex decoded_mutex;
+  std::vector<DecodedImage> decoded;
+
+  std::deque<Upload> uploads;
+};
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+#include "trujkont/texture/texture_streamer.hpp"
+
+#include <fmt/format.h>
+
+#include "trujkont/asset_pack/asset_pack.hpp"
+#include "trujkont/gl_state/gl_state.hpp"
+
+namespace
+{
+
+// Touching one byte of every page is enough to fault the whole page in.
+auto constexpr page_size = std::size_t(4096);
+
+auto constexpr block_extent = 4;
+
+auto level_size(CompressedMip const& mip, bool const decodes) -> std::size_t
+{
+  return decodes ? static_cast<std::size_t>(mip.width) * static_cast<std::size_t>(mip.height) * 4 : mip.blocks.size();
+}
+
+// `data` may be null, which only allocates the level, its contents are then uploaded with sub image calls.
+auto specify_level(BlockFormat const format, bool const decodes, GLint const level, CompressedMip const& mip, void const* const data) -> void
+{
+  if(decodes) {
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  } else {
+    glCompressedTexImage2D(
+      GL_TEXTURE_2D,
+      level,
+      gl_compressed_format(format),
+      mip.width,
+      mip.height,
+      0,
+      static_cast<GLsizei>(mip.blocks.size()),
+      data
+    );
+  }
+}
+
+} // namespace
+
+auto projected_size(float const radius, float const distance, float const field_of_view, int const viewport_height) noexcept -> float
+{
+  // From inside the sphere it covers the whole screen, and then some.
+  auto const clamped_distance = std::max(distance, radius);
+
+  return radius / (clamped_distance * std::tan(field_of_view / 2.0F)) * static_cast<float>(viewport_height);
+}
+
+TextureStreamer::TextureStreamer(JobSystem& jobs, StreamBuffer& stream, std::size_t const upload_budget)
+  : jobs(jobs),
+    stream(stream),
+    upload_budget(upload_budget),
+    upload_unit(next_texture_slot())
+{}
+
+TextureStreamer::~TextureStreamer()
+{
+  jobs.wait(prefetching);
+
+  for(auto const& texture : textures) {
+    gpu_memory::release(texture->allocation);
+
+    gl_state::forget_texture(texture->id);
+    glDeleteTextures(1, &texture->id);
+  }
+}
+
+auto TextureStreamer::load(std::filesystem::path const& path) -> tl::expected<std::shared_ptr<StreamedTexture const>, std::string>
+{
+  auto texture = std::make_shared<StreamedTexture>();
+
+  if(auto const packed = assets::find(path)) {
+    auto parsed = parse_compressed_texture(*packed);
+    if(not parsed) return tl::make_unexpected(fmt::format("\"{}\": {}", path.c_str(), parsed.error()));
+
+    texture->source = std::move(*parsed);
+  } else {
+    auto read = read_compressed_texture(path);
+    if(not read) return tl::make_unexpected(read.error());
+
+    texture->loose = std::move(*read);
+    texture->source = texture->loose.view;
+  }
+
+  auto const& source = texture->source;
+  auto const& mips = source.mips;
+
+  // The chain may stop before reaching `resident_extent`, its last mip is the coarsest there is then.
+  auto const coarse = std::ranges::find_if(mips, [](CompressedMip const& mip) {
+    return std::max(mip.width, mip.height) <= resident_extent;
+  });
+
+  texture->slot = next_texture_slot();
+  texture->index = textures.size();
+  texture->decodes = not compressed_format_supported(source.format);
+  texture->coarse_level = coarse == mips.end() ? mips.size() - 1 : static_cast<std::size_t>(coarse - mips.begin());
+  texture->base_level = texture->coarse_level;
+
+  glGenTextures(1, &texture->id);
+
+  gl_state::active_texture(texture->slot);
+  gl_state::bind_texture(GL_TEXTURE_2D, texture->id);
+
+  // A few KiB at most, uploaded straight away so the texture never samples as incomplete.
+  for(auto level = texture->coarse_level; level < mips.size(); ++level) {
+    auto const& mip = mips[level];
+    auto const gl_level = static_cast<GLint>(level);
+
+    if(texture->decodes) {
+      auto const pixels = decode_blocks(mip.blocks, mip.width, mip.height, source.format);
+      specify_level(source.format, true, gl_level, mip, pixels.data());
+    } else {
+      specify_level(source.format, false, gl_level, mip, mip.blocks.data());
+    }
+
+    resident_size.fetch_add(level_size(mip, texture->decodes), std::memory_order_relaxed);
+  }
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(texture->base_level));
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mips.size()) - 1);
+
+  texture->allocation = gpu_memory::track(
+    gpu_memory::Category::Texture,
+    resident_size_of(*texture),
+    path.string(),
+    [this, &streamed = *texture] {
+      if(streamed.streaming or streamed.base_level == streamed.coarse_level) return false;
+
+      drop_levels(streamed, streamed.coarse_level);
+      return true;
+    }
+  );
+
+  textures.push_back(texture);
+  textures_loaded.store(textures.size(), std::memory_order_relaxed);
+
+  return texture;
+}
+
+auto TextureStreamer::request(StreamedTexture const& texture, float const size) -> void
+{
+  auto& requested_size = textures[texture.index]->requested_size;
+  requested_size = std::max(requested_size, size);
+}
+
+auto TextureStreamer::update() -> void
+{
+  {
+    auto const lock = std::scoped_lock(prefetched_mutex);
+
+    for(auto& mip : prefetched) {
+      auto const& texture = *mip.texture;
+
+      // Allocated now, while no pixel unpack buffer is bound, the null data would be read as an offset into it otherwise.
+      gl_state::active_texture(upload_unit);
+      gl_state::bind_texture(GL_TEXTURE_2D, texture.id);
+      specify_level(texture.source.format, texture.decodes, static_cast<GLint>(mip.level), texture.source.mips[mip.level], nullptr);
+
+      uploads.push_back(Upload { .mip = std::move(mip), .rows_uploaded = 0 });
+    }
+
+    prefetched.clear();
+  }
+
+  for(auto const& texture : textures) {
+    auto const wanted = wanted_level(*texture);
+
+    if(texture->requested_size > 0.0F) gpu_memory::touch(texture->allocation);
+    texture->requested_size = 0.0F;
+
+    // One mip at a time, each finer one is shown as soon as it's in rather than after the whole chain.
+    if(wanted < texture->base_level and not texture->streaming) {
+      auto const finer_level = texture->base_level - 1;
+      if(gpu_memory::fits(level_size(texture->source.mips[finer_level], texture->decodes))) prefetch(texture, finer_level);
+    }
+
+    if(wanted <= texture->base_level or texture->streaming) {
+      texture->frames_unneeded = 0;
+    } else if(++texture->frames_unneeded >= frames_to_drop) {
+      drop_levels(*texture, wanted);
+    }
+  }
+
+  if(not uploads.empty()) {
+    auto frame = PixelUploadFrame(stream, upload_budget);
+
+    while(not uploads.empty() and upload_rows(uploads.front(), frame)) {
+      finish(uploads.front());
+      uploads.pop_front();
+    }
+  }
+
+  uploads_pending.store(uploads.size(), std::memory_order_relaxed);
+}
+
+auto TextureStreamer::resident_bytes() const noexcept -> std::size_t
+{
+  return resident_size.load(std::memory_order_relaxed);
+}
+
+auto TextureStreamer::report() const -> std::string
+{
+  return fmt::format(
+    "streaming: {} textures, {:.2f} MiB resident, {} mips streamed in, {} dropped, {} uploading\n",
+    textures_loaded.load(std::memory_order_relaxed),
+    static_cast<double>(resident_size.load(std::memory_order_relaxed)) / (1024.0 * 1024.0),
+    levels_streamed.load(std::memory_order_relaxed),
+    levels_dropped.load(std::memory_order_relaxed),
+    uploads_pending.load(std::memory_order_relaxed)
+  );
+}
+
+auto TextureStreamer::wanted_level(StreamedTexture const& texture) const noexcept -> std::size_t
+{
+  if(texture.requested_size <= 0.0F) return texture.coarse_level;
+
+  auto const& full = texture.source.mips.front();
+  auto const texels_per_pixel = static_cast<float>(std::max(full.width, full.height)) / texture.requested_size;
+
+  // Each mip halves the texels, the finest one still not below a texel per pixel is as sharp as the screen can show.
+  if(texels_per_pixel <= 1.0F) return 0;
+
+  return std::min(static_cast<std::size_t>(std::log2(texels_per_pixel)), texture.coarse_level);
+}
+
+auto TextureStreamer::prefetch(std::shared_ptr<StreamedTexture> const& texture, std::size_t const level) -> void
+{
+  texture->streaming = true;
+
+  jobs.submit(
+    [this, texture, level] {
+      auto const& source = texture->source;
+      auto const& mip = source.mips[level];
+
+      auto prefetched_mip = PrefetchedMip { .texture = texture, .level = level, .pixels = {} };
+
+      if(texture->decodes) {
+        prefetched_mip.pixels = decode_blocks(mip.blocks, mip.width, mip.height, source.format);
+      } else {
+        // Faulting a pack mapping's pages in is the actual disk read, better here than in the main thread's copy.
+        auto touched = std::byte(0);
+        for(auto offset = std::size_t(0); offset < mip.blocks.size(); offset += page_size) {
+          touched |= *static_cast<std::byte const volatile*>(mip.blocks.data() + offset);
+        }
+
+        static_cast<void>(touched);
+      }
+
+      auto const lock = std::scoped_lock(prefetched_mutex);
+      prefetched.push_back(std::move(prefetched_mip));
+    },
+    &prefetching
+  );
+}
+
+auto TextureStreamer::upload_rows(Upload& upload, PixelUploadFrame& frame) -> bool
+{
+  auto const& texture = *upload.mip.texture;
+  auto const& mip = texture.source.mips[upload.mip.level];
+  auto const level = static_cast<GLint>(upload.mip.level);
+
+  // Compressed sub images have to start on a block boundary, decoded ones are uploaded in the same rows of 4 pixels,
+  // the last of which may be less than 4 pixels high.
+  auto const bytes = texture.decodes ? std::span<std::byte const>(upload.mip.pixels) : mip.blocks;
+  auto const rows_count = (mip.height + block_extent - 1) / block_extent;
+  auto const row_size = texture.decodes ? static_cast<std::size_t>(mip.width) * 4 * block_extent : bytes.size() / static_cast<std::size_t>(rows_count);
+
+  gl_state::active_texture(upload_unit);
+  gl_state::bind_texture(GL_TEXTURE_2D, texture.id);
+
+  return frame.upload_rows(bytes, row_size, rows_count, upload.rows_uploaded, [&](StagedRows const& rows) {
+    auto const y = rows.first_row * block_extent;
+    auto const height = std::min(rows.rows * block_extent, mip.height - y);
+
+    if(texture.decodes) {
+      glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, mip.width, height, GL_RGBA, GL_UNSIGNED_BYTE, rows.pixels);
+    } else {
+      glCompressedTexSubImage2D(
+        GL_TEXTURE_2D,
+        level,
+        0,
+        y,
+        mip.width,
+        height,
+        gl_compressed_format(texture.source.format),
+        static_cast<GLsizei>(rows.size),
+        rows.pixels
+      );
+    }
+  });
+}
+
+auto TextureStreamer::finish(Upload& upload) -> void
+{
+  auto& texture = *upload.mip.texture;
+
+  // Still bound to the upload unit by `upload_rows`. Sampling only moves onto the mip now that all of it is there.
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(upload.mip.level));
+
+  texture.base_level = upload.mip.level;
+  texture.streaming = false;
+
+  resident_size.fetch_add(level_size(texture.source.mips[upload.mip.level], texture.decodes), std::memory_order_relaxed);
+  levels_streamed.fetch_add(1, std::memory_order_relaxed);
+
+  gpu_memory::resize(texture.allocation, resident_size_of(texture));
+}
+
+auto TextureStreamer::drop_levels(StreamedTexture& texture, std::size_t const level) -> void
+{
+  gl_state::active_texture(upload_unit);
+  gl_state::bind_texture(GL_TEXTURE_2D, texture.id);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+
+  // Respecified as empty, which is what gives their memory back, levels outside of the base and max ones don't need to be complete.
+  for(auto dropped = texture.base_level; dropped < level; ++dropped) {
+    glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(dropped), GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    resident_size.fetch_sub(level_size(texture.source.mips[dropped], texture.decodes), std::memory_order_relaxed);
+    levels_dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  texture.base_level = level;
+  texture.frames_unneeded = 0;
+
+  gpu_memory::resize(texture.allocation, resident_size_of(texture));
+}
+
+auto TextureStreamer::resident_size_of(StreamedTexture const& texture) const -> std::size_t
+{
+  auto size = std::size_t(0);
+
+  for(auto level = texture.base_level; level < texture.source.mips.size(); ++level) {
+    size += level_size(texture.source.mips[level], texture.decodes);
+  }
+
+  return size;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <filesystem>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <tl/expected.hpp>
+
+#include "trujkont/block_compression/compressed_texture.hpp"
+#include "trujkont/stream_buffer/stream_buffer.hpp"
+#include "trujkont/stream_buffer/pixel_upload.hpp"
+#include "trujkont/gpu_memory/gpu_memory.hpp"
+#include "trujkont/texture/texture.hpp"
+#include "trujkont/jobs/job_system.hpp"
+
+// A baked texture of which only some mips are resident. Its slot is valid right away and always samples the finest
+// resident mip, which changes as the streamer brings finer ones in or drops them.
+class StreamedTexture
+{
+public:
+  [[nodiscard]] auto get_slot() const noexcept -> TextureSlot { return slot; }
+
+  // 0 is the full size image, `levels_count() - 1` the smallest one.
+  [[nodiscard]] auto resident_level() const noexcept -> std::size_t { return base_level; }
+
+  [[nodiscard]] auto levels_count() const noexcept -> std::size_t { return source.mips.size(); }
+
+private:
+  friend class TextureStreamer;
+
+  TextureSlot slot = 0;
+  GLuint id = 0;
+
+  // In the streamer's `textures`.
+  std::size_t index = 0;
+
+  // Evicting it drops every mip above `coarse_level`.
+  gpu_memory::AllocationId allocation = 0;
+
+  // Loose files are read in whole, `source` then points into `loose`, otherwise into the asset pack's pages.
+  CompressedTextureFile loose;
+  CompressedTextureView source;
+  bool decodes = false;
+
+  std::size_t base_level = 0;
+  std::size_t coarse_level = 0;
+  bool streaming = false;
+
+  // The largest `request` since the last `update`, in pixels.
+  float requested_size = 0.0F;
+  std::size_t frames_unneeded = 0;
+};
+
+// Pixels across a sphere of `radius` on screen at `distance` from a perspective camera, the size `TextureStreamer::request` takes.
+[[nodiscard]] auto projected_size(float radius, float distance, float field_of_view, int viewport_height) noexcept -> float;
+
+// Keeps the mips of baked (`.tbc`) textures resident only while something on screen is drawn large enough to need them.
+// Loading uploads just the small mips, every frame the finest size each texture was requested at picks the mip it needs.
+// Finer mips are paged in (or decoded, without driver support for the format) on the job system, then uploaded one
+// block row range at a time through a `PixelUploadFrame`, at most `upload_budget` bytes per frame, and only become visible
+// once complete. Mips no longer needed for `frames_to_drop` frames are released again, so VRAM follows what is on screen.
+// Finer mips are not streamed in while they don't fit in `gpu_memory`'s budget, which evicts textures left off screen first.
+//
+// Usage per frame: any number of `request()`, then `update()` between the stream's `begin_frame()` and `end_frame()`.
+class TextureStreamer
+{
+public:
+  auto inline static constexpr default_upload_budget = std::size_t(4 * 1024 * 1024);
+
+  // Mips up to this size are always resident, they cost little and make every texture show something right away.
+  auto inline static constexpr resident_extent = 64;
+
+  // A second or two, so turning the camera back and forth doesn't stream the same mip over and over.
+  auto inline static constexpr frames_to_drop = std::size_t(120);
+
+  TextureStreamer(JobSystem& jobs, StreamBuffer& stream, std::size_t upload_budget = default_upload_budget);
+
+  TextureStreamer(TextureStreamer const&) = delete;
+  TextureStreamer(TextureStreamer&&) = delete;
+  auto operator=(TextureStreamer const&) -> TextureStreamer& = delete;
+  auto operator=(TextureStreamer&&) -> TextureStreamer& = delete;
+
+  // Waits for the mips still being prefetched, they are written into the streamer.
+  ~TextureStreamer();
+
+  // From the mounted asset pack when it has `path`, the blocks are then read straight from its pages as they are needed.
+  [[nodiscard]] auto load(std::filesystem::path const& path) -> tl::expected<std::shared_ptr<StreamedTexture const>, std::string>;
+
+  // `size` is how many pixels the texture covers on screen this frame, along its longer side.
+  auto request(StreamedTexture const& texture, float size) -> void;
+
+  auto update() -> void;
+
+  [[nodiscard]] auto resident_bytes() const noexcept -> std::size_t;
+
+  // Safe to call from any thread.
+  [[nodiscard]] auto report() const -> std::string;
+
+private:
+  struct PrefetchedMip
+  {
+    std::shared_ptr<StreamedTexture> texture;
+    std::size_t level = 0;
+
+    // Decoded RGBA pixels for textures that `decodes`, otherwise empty and the mip's blocks are used as they are.
+    std::vector<std::byte> pixels;
+  };
+
+  struct Upload
+  {
+    PrefetchedMip mip;
+    int rows_uploaded = 0;
+  };
+
+  [[nodiscard]] auto wanted_level(StreamedTexture const& texture) const noexcept -> std::size_t;
+
+  auto prefetch(std::shared_ptr<StreamedTexture> const& texture, std::size_t level) -> void;
+
+  // Returns false when the frame has no room left, the rest of the mip is uploaded in the next ones.
+  auto upload_rows(Upload& upload, PixelUploadFrame& frame) -> bool;
+
+  auto finish(Upload& upload) -> void;
+
+  auto drop_levels(StreamedTexture& texture, std::size_t level) -> void;
+
+  [[nodiscard]] auto resident_size_of(StreamedTexture const& texture) const -> std::size_t;
+
+  JobSystem& jobs;
+  StreamBuffer& stream;
+  std::size_t upload_budget;
+
+  // Mips being uploaded are bound here, every other unit belongs to a texture.
+  TextureSlot upload_unit = 0;
+
+  std::vector<std::shared_ptr<StreamedTexture>> textures;
+
+  JobCounter prefetching;
+
+  std::mutex prefetched_mutex;
+  std::vector<PrefetchedMip> prefetched;
+
+  std::deque<Upload> uploads;
+
+  // Read by `report`, which the commandline calls from its own thread.
+  std::atomic<std::size_t> textures_loaded = 0;
+  std::atomic<std::size_t> resident_size = 0;
+  std::atomic<std::size_t> uploads_pending = 0;
+  std::atomic<std::uint64_t> levels_streamed = 0;
+  std::atomic<std::uint64_t> levels_dropped = 0;
+};
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <numbers>
+#include <random>
+#include <vector>
+#include <array>
+#include <cmath>
+
+#include "trujkont/transform/transform_benchmark.hpp"
+#include "trujkont/transform/transform_store.hpp"
+#include "trujkont/benchmark/best_time.hpp"
+
+#include <fmt/format.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+
+auto constexpr runs = 10;
+
+auto max_difference(std::vector<glm::mat4> const& expected, std::vector<glm::mat4> const& actual)
+{
+  auto difference = 0.0F;
+
+  for(auto i = std::size_t(0); i < expected.size(); ++i) {
+    for(auto column = 0; column < 4; ++column) {
+      for(auto row = 0; row < 4; ++row) {
+        difference = std::max(difference, std::abs(expected[i][column][row] - actual[i][column][row]));
+      }
+    }
+  }
+
+  return difference;
+}
+
+} // namespace
+
+auto benchmark_transforms(std::size_t const count) -> std::string
+{
+  auto generator = std::mt19937(2137); // NOLINT
+  auto coordinate = std::uniform_real_distribution(-100.0F, 100.0F);
+  auto angle = std::uniform_real_distribution(-2 * std::numbers::pi_v<float>, 2 * std::numbers::pi_v<float>);
+  auto scale = std::uniform_real_distribution(0.25F, 4.0F);
+
+  auto transforms = TransformStore();
+  transforms.reserve(count);
+
+  for(auto i = std::size_t(0); i < count; ++i) {
+    auto axis = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+    if(glm::length(axis) < 1e-3F) axis = glm::vec3(0., 1., 0.);
+
+    transforms.push(
+      glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)),
+      axis,
+      angle(generator),
+      glm::vec3(scale(generator), scale(generator), scale(generator))
+    );
+  }
+
+  auto expected = std::vector<glm::mat4>(count);
+
+  auto const glm_time = best_time(runs, [&] {
+    for(auto i = std::size_t(0); i < count; ++i) {
+      auto model = glm::mat4(1.0F);
+      model = glm::translate(model, glm::vec3(transforms.position_x[i], transforms.position_y[i], transforms.position_z[i]));
+      model = glm::rotate(model, transforms.angle[i], glm::vec3(transforms.axis_x[i], transforms.axis_y[i], transforms.axis_z[i]));
+      model = glm::scale(model, glm::vec3(transforms.scale_x[i], transforms.scale_y[i], transforms.scale_z[i]));
+
+      expected[i] = model;
+    }
+  });
+
+  auto report = fmt::format("{} transforms, best of {} runs\n{:>8}: {:8.3f} ms\n", count, runs, "glm", glm_time);
+
+  auto actual = std::vector<glm::mat4>(count);
+
+  for(auto const level : { SimdLevel::Scalar, SimdLevel::Sse, SimdLevel::Avx2 }) {
+    if(level > best_simd_level()) break;
+
+    auto const time = best_time(runs, [&] { write_model_matrices(transforms, actual, level); });
+
+    report += fmt::format(
+      "{:>8}: {:8.3f} ms, {:5.2f}x glm, max error {:.2e}\n",
+      simd_level_name(level),
+      time,
+      glm_time / time,
+      max_difference(expected, actual)
+    );
+  }
+
+  return report;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Checks every compiled in model matrix kernel against the plain glm translate/rotate/scale chain
+// and times them all on `count` random transforms. Returns a human readable report.
+auto benchmark_transforms(std::size_t count) -> std::string;
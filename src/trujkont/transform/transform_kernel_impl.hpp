@@ -0,0 +1,88 @@
+#pragma once
+
+#include "trujkont/transform/transform_kernels.hpp"
+#include "trujkont/simd/simd_float.hpp"
+#include "trujkont/simd/simd_math.hpp"
+
+namespace // NOLINT(cert-dcl59-cpp): see simd_float.hpp
+{
+
+// `load(array)` fetches the batch's lanes of one component array, either contiguously or through an index list.
+template<typename V, typename Load>
+auto write_model_matrices_batch(TransformArrays const& transforms, Load const& load, float* const out) -> void
+{
+  auto const px = load(transforms.position_x);
+  auto const py = load(transforms.position_y);
+  auto const pz = load(transforms.position_z);
+
+  auto const ax = load(transforms.axis_x);
+  auto const ay = load(transforms.axis_y);
+  auto const az = load(transforms.axis_z);
+
+  auto const sx = load(transforms.scale_x);
+  auto const sy = load(transforms.scale_y);
+  auto const sz = load(transforms.scale_z);
+
+  auto sine = typename V::Float();
+  auto cosine = typename V::Float();
+  sincos<V>(load(transforms.angle), sine, cosine);
+
+  // Rodrigues' rotation matrix, term for term what glm::rotate builds.
+  auto const one_minus_cosine = V::sub(V::set1(1.0F), cosine);
+
+  auto const tx = V::mul(ax, one_minus_cosine);
+  auto const ty = V::mul(ay, one_minus_cosine);
+  auto const tz = V::mul(az, one_minus_cosine);
+
+  auto const r00 = V::fmadd(tx, ax, cosine);
+  auto const r01 = V::fmadd(tx, ay, V::mul(sine, az));
+  auto const r02 = V::sub(V::mul(tx, az), V::mul(sine, ay));
+
+  auto const r10 = V::sub(V::mul(ty, ax), V::mul(sine, az));
+  auto const r11 = V::fmadd(ty, ay, cosine);
+  auto const r12 = V::fmadd(ty, az, V::mul(sine, ax));
+
+  auto const r20 = V::fmadd(tz, ax, V::mul(sine, ay));
+  auto const r21 = V::sub(V::mul(tz, ay), V::mul(sine, ax));
+  auto const r22 = V::fmadd(tz, az, cosine);
+
+  auto const zero = V::set1(0.0F);
+  auto const one = V::set1(1.0F);
+
+  auto constexpr matrix_stride = std::size_t(16);
+
+  V::store_transposed(out, matrix_stride, V::mul(r00, sx), V::mul(r01, sx), V::mul(r02, sx), zero);
+  V::store_transposed(out + 4, matrix_stride, V::mul(r10, sy), V::mul(r11, sy), V::mul(r12, sy), zero);
+  V::store_transposed(out + 8, matrix_stride, V::mul(r20, sz), V::mul(r21, sz), V::mul(r22, sz), zero);
+  V::store_transposed(out + 12, matrix_stride, px, py, pz, one);
+}
+
+template<typename V>
+auto write_model_matrices(TransformArrays const& transforms, std::size_t const count, float* const out) -> void
+{
+  auto i = std::size_t(0);
+
+  for(; i + V::width <= count; i += V::width) {
+    write_model_matrices_batch<V>(transforms, [i](float const* array) { return V::load(array + i); }, out + i * 16);
+  }
+
+  for(; i < count; ++i) {
+    write_model_matrices_batch<ScalarFloats>(transforms, [i](float const* array) { return ScalarFloats::load(array + i); }, out + i * 16);
+  }
+}
+
+template<typename V>
+auto write_model_matrices_indexed(TransformArrays const& transforms, std::uint32_t const* const indices, std::size_t const count, float* const out) -> void
+{
+  auto i = std::size_t(0);
+
+  for(; i + V::width <= count; i += V::width) {
+    write_model_matrices_batch<V>(transforms, [=](float const* array) { return V::gather(array, indices + i); }, out + i * 16);
+  }
+
+  for(; i < count; ++i) {
+    write_model_matrices_batch<ScalarFloats>(transforms, [=](float const* array) { return ScalarFloats::gather(array, indices + i); }, out + i * 16);
+  }
+}
+
+} // namespace
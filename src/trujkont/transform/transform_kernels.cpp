@@ -0,0 +1,48 @@
+#include "trujkont/transform/transform_kernel_impl.hpp"
+
+namespace transform_kernels
+{
+
+auto write_model_matrices_scalar(TransformArrays const& transforms, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices<ScalarFloats>(transforms, count, out);
+}
+
+auto write_model_matrices_sse(TransformArrays const& transforms, std::size_t const count, float* const out) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  write_model_matrices<SseFloats>(transforms, count, out);
+#else
+  write_model_matrices<ScalarFloats>(transforms, count, out);
+#endif
+}
+
+auto write_model_matrices_indexed_scalar(TransformArrays const& transforms, std::uint32_t const* const indices, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices_indexed<ScalarFloats>(transforms, indices, count, out);
+}
+
+auto write_model_matrices_indexed_sse(TransformArrays const& transforms, std::uint32_t const* const indices, std::size_t const count, float* const out) -> void
+{
+#if defined(TRUJKONT_SSE_KERNELS)
+  write_model_matrices_indexed<SseFloats>(transforms, indices, count, out);
+#else
+  write_model_matrices_indexed<ScalarFloats>(transforms, indices, count, out);
+#endif
+}
+
+#if not defined(TRUJKONT_AVX2_KERNELS)
+
+auto write_model_matrices_avx2(TransformArrays const& transforms, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices_sse(transforms, count, out);
+}
+
+auto write_model_matrices_indexed_avx2(TransformArrays const& transforms, std::uint32_t const* const indices, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices_indexed_sse(transforms, indices, count, out);
+}
+
+#endif
+
+} // namespace transform_kernels
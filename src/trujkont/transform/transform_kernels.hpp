@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Raw views of the structure-of-arrays transform data, everything the batch kernels need.
+// Kept free of standard library types so the per instruction set kernel units can share it safely (see simd_float.hpp).
+struct TransformArrays
+{
+  float const* position_x = nullptr;
+  float const* position_y = nullptr;
+  float const* position_z = nullptr;
+
+  // Unit length.
+  float const* axis_x = nullptr;
+  float const* axis_y = nullptr;
+  float const* axis_z = nullptr;
+
+  float const* angle = nullptr;
+
+  float const* scale_x = nullptr;
+  float const* scale_y = nullptr;
+  float const* scale_z = nullptr;
+};
+
+// Each writes `count` column major affine model matrices (translate * rotate * scale, same as the glm chain would)
+// for transforms [0, count) to `out`, 16 floats apiece.
+namespace transform_kernels
+{
+
+auto write_model_matrices_scalar(TransformArrays const& transforms, std::size_t count, float* out) -> void;
+
+auto write_model_matrices_sse(TransformArrays const& transforms, std::size_t count, float* out) -> void;
+
+auto write_model_matrices_avx2(TransformArrays const& transforms, std::size_t count, float* out) -> void;
+
+// Same, but for transforms `indices[0 .. count)`, e.g. only the ones that survived culling.
+auto write_model_matrices_indexed_scalar(TransformArrays const& transforms, std::uint32_t const* indices, std::size_t count, float* out) -> void;
+
+auto write_model_matrices_indexed_sse(TransformArrays const& transforms, std::uint32_t const* indices, std::size_t count, float* out) -> void;
+
+auto write_model_matrices_indexed_avx2(TransformArrays const& transforms, std::uint32_t const* indices, std::size_t count, float* out) -> void;
+
+} // namespace transform_kernels
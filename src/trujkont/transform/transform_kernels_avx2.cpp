@@ -0,0 +1,17 @@
+#include "trujkont/simd/simd_float_avx2.hpp"
+#include "trujkont/transform/transform_kernel_impl.hpp"
+
+namespace transform_kernels
+{
+
+auto write_model_matrices_avx2(TransformArrays const& transforms, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices<Avx2Floats>(transforms, count, out);
+}
+
+auto write_model_matrices_indexed_avx2(TransformArrays const& transforms, std::uint32_t const* const indices, std::size_t const count, float* const out) -> void
+{
+  write_model_matrices_indexed<Avx2Floats>(transforms, indices, count, out);
+}
+
+} // namespace transform_kernels
@@ -0,0 +1,127 @@
+#include <stdexcept>
+
+#include "trujkont/transform/transform_store.hpp"
+
+#include <fmt/format.h>
+
+auto TransformStore::push(glm::vec3 const position, glm::vec3 const rotation_axis, float const angle, glm::vec3 const scale) -> std::size_t
+{
+  position_x.push_back(position.x);
+  position_y.push_back(position.y);
+  position_z.push_back(position.z);
+
+  axis_x.emplace_back();
+  axis_y.emplace_back();
+  axis_z.emplace_back();
+
+  this->angle.push_back(angle);
+
+  scale_x.push_back(scale.x);
+  scale_y.push_back(scale.y);
+  scale_z.push_back(scale.z);
+
+  auto const index = size() - 1;
+  set_rotation_axis(index, rotation_axis);
+
+  return index;
+}
+
+auto TransformStore::reserve(std::size_t const count) -> void
+{
+  for(auto* const component : { &position_x, &position_y, &position_z, &axis_x, &axis_y, &axis_z, &angle, &scale_x, &scale_y, &scale_z }) {
+    component->reserve(count);
+  }
+}
+
+auto TransformStore::clear() -> void
+{
+  for(auto* const component : { &position_x, &position_y, &position_z, &axis_x, &axis_y, &axis_z, &angle, &scale_x, &scale_y, &scale_z }) {
+    component->clear();
+  }
+}
+
+auto TransformStore::swap_remove(std::size_t const index) -> void
+{
+  for(auto* const component : { &position_x, &position_y, &position_z, &axis_x, &axis_y, &axis_z, &angle, &scale_x, &scale_y, &scale_z }) {
+    (*component)[index] = component->back();
+    component->pop_back();
+  }
+}
+
+auto TransformStore::size() const noexcept -> std::size_t
+{
+  return position_x.size();
+}
+
+auto TransformStore::arrays(std::size_t const first) const noexcept -> TransformArrays
+{
+  return TransformArrays {
+    .position_x = position_x.data() + first,
+    .position_y = position_y.data() + first,
+    .position_z = position_z.data() + first,
+    .axis_x = axis_x.data() + first,
+    .axis_y = axis_y.data() + first,
+    .axis_z = axis_z.data() + first,
+    .angle = angle.data() + first,
+    .scale_x = scale_x.data() + first,
+    .scale_y = scale_y.data() + first,
+    .scale_z = scale_z.data() + first,
+  };
+}
+
+auto TransformStore::set_rotation_axis(std::size_t const index, glm::vec3 const axis) -> void
+{
+  // Normalized once here rather than for every matrix, like glm::rotate has to.
+  auto const unit_axis = glm::normalize(axis);
+
+  axis_x[index] = unit_axis.x;
+  axis_y[index] = unit_axis.y;
+  axis_z[index] = unit_axis.z;
+}
+
+auto write_model_matrices(TransformStore const& transforms, std::size_t const first, std::span<glm::mat4> const out, SimdLevel const level) -> void
+{
+  if(first + out.size() > transforms.size()) {
+    throw std::out_of_range(fmt::format(
+      "Asked for model matrices [{}, {}), but there are only {} transforms",
+      first,
+      first + out.size(),
+      transforms.size()
+    ));
+  }
+
+  auto const arrays = transforms.arrays(first);
+  auto* const out_floats = reinterpret_cast<float*>(out.data()); // NOLINT
+
+  switch(level) {
+    case SimdLevel::Scalar: transform_kernels::write_model_matrices_scalar(arrays, out.size(), out_floats); break;
+    case SimdLevel::Sse: transform_kernels::write_model_matrices_sse(arrays, out.size(), out_floats); break;
+    case SimdLevel::Avx2: transform_kernels::write_model_matrices_avx2(arrays, out.size(), out_floats); break;
+  }
+}
+
+auto write_model_matrices(TransformStore const& transforms, std::span<glm::mat4> const out, SimdLevel const level) -> void
+{
+  write_model_matrices(transforms, 0, out, level);
+}
+
+auto write_model_matrices(
+  TransformStore const& transforms,
+  std::span<std::uint32_t const> const indices,
+  std::span<glm::mat4> const out,
+  SimdLevel const level
+) -> void
+{
+  if(indices.size() != out.size()) {
+    throw std::invalid_argument(fmt::format("Got {} transform indices, but room for {} model matrices", indices.size(), out.size()));
+  }
+
+  auto const arrays = transforms.arrays();
+  auto* const out_floats = reinterpret_cast<float*>(out.data()); // NOLINT
+
+  switch(level) {
+    case SimdLevel::Scalar: transform_kernels::write_model_matrices_indexed_scalar(arrays, indices.data(), out.size(), out_floats); break;
+    case SimdLevel::Sse: transform_kernels::write_model_matrices_indexed_sse(arrays, indices.data(), out.size(), out_floats); break;
+    case SimdLevel::Avx2: transform_kernels::write_model_matrices_indexed_avx2(arrays, indices.data(), out.size(), out_floats); break;
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include "trujkont/transform/transform_kernels.hpp"
+#include "trujkont/simd/cpu_features.hpp"
+
+// Positions, axis-angle rotations and scales of many objects, one array per component,
+// so batch kernels can load the same component of several objects with a single instruction.
+class TransformStore
+{
+public:
+  auto push(glm::vec3 position, glm::vec3 rotation_axis, float angle, glm::vec3 scale = glm::vec3(1.)) -> std::size_t;
+
+  auto reserve(std::size_t count) -> void;
+
+  auto clear() -> void;
+
+  // Moves the last transform into `index`, O(1) but doesn't keep the order.
+  auto swap_remove(std::size_t index) -> void;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  // Views starting at transform `first`.
+  [[nodiscard]] auto arrays(std::size_t first = 0) const noexcept -> TransformArrays;
+
+  auto set_rotation_axis(std::size_t index, glm::vec3 axis) -> void;
+
+  std::vector<float> position_x;
+  std::vector<float> position_y;
+  std::vector<float> position_z;
+
+  std::vector<float> axis_x;
+  std::vector<float> axis_y;
+  std::vector<float> axis_z;
+
+  // Radians, kept within [-2pi, 2pi] by whoever animates them, the batch sine/cosine is tuned for small arguments.
+  std::vector<float> angle;
+
+  std::vector<float> scale_x;
+  std::vector<float> scale_y;
+  std::vector<float> scale_z;
+};
+
+// Writes the model matrices of transforms [first, first + out.size()) straight into `out` (e.g. a mapped instance buffer).
+auto write_model_matrices(TransformStore const& transforms, std::size_t first, std::span<glm::mat4> out, SimdLevel level = best_simd_level()) -> void;
+
+auto write_model_matrices(TransformStore const& transforms, std::span<glm::mat4> out, SimdLevel level = best_simd_level()) -> void;
+
+// Writes the model matrix of transform `indices[i]` to `out[i]`, `out` has to be as big as `indices`.
+auto write_model_matrices(TransformStore const& transforms, std::span<std::uint32_t const> indices, std::span<glm::mat4> out, SimdLevel level = best_simd_level()) -> void;
@@ -1,22 +1,55 @@
 #include "trujkont/trujkont.hpp"
 
 #include <algorithm>
+#include <charconv>
 #include <cstdlib>
+#include <filesystem>
+#include <cmath>
 #include <numbers>
+#include <ranges>
 #include <random>
+#include <limits>
+#include <atomic>
 #include <chrono>
+#include <vector>
 #include <array>
+#include <span>
 
-#include <trujkont/shader_program/shader_program.hpp>
+#include <trujkont/shader_program/program_binary.hpp>
+#include <trujkont/asset_pack/asset_pack.hpp>
+#include <trujkont/shader_program/program_cache.hpp>
+#include <trujkont/shader_program/shader_watcher.hpp>
+#include <trujkont/instanced_cubes/instanced_cubes.hpp>
 #include <trujkont/commandline/commandline.hpp>
 #include <trujkont/delta_time/delta_time.hpp>
-#include <trujkont/shader_program/shader.hpp>
 #include <trujkont/callbacks/callbacks.hpp>
-#include <trujkont/billboard/billboard.hpp>
+#include <trujkont/gl_state/gl_state.hpp>
+#include <trujkont/gpu_memory/gpu_memory.hpp>
+#include <trujkont/billboard/billboard_batch.hpp>
+#include <trujkont/texture/texture_loader.hpp>
+#include <trujkont/texture/texture_streamer.hpp>
+#include <trujkont/mipmaps/mip_cache.hpp>
+#include <trujkont/texture/texture_array_pool.hpp>
+#include <trujkont/texture/texture_atlas.hpp>
 #include <trujkont/texture/texture.hpp>
+#include <trujkont/camera/camera_buffer.hpp>
 #include <trujkont/camera/camera.hpp>
+#include <trujkont/stream_buffer/stream_buffer.hpp>
+#include <trujkont/transform/transform_benchmark.hpp>
+#include <trujkont/transform/transform_store.hpp>
+#include <trujkont/jobs/job_benchmark.hpp>
+#include <trujkont/jobs/job_system.hpp>
+#include <trujkont/culling/culling_benchmark.hpp>
+#include <trujkont/culling/gpu_culling.hpp>
+#include <trujkont/culling/culling.hpp>
+#include <trujkont/bvh/bvh_benchmark.hpp>
+#include <trujkont/block_compression/block_compression_benchmark.hpp>
+#include <trujkont/pixels/pixel_benchmark.hpp>
+#include <trujkont/bvh/bvh.hpp>
+#include <trujkont/scene/scene.hpp>
 
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 
 // clang-format off
 #include <GLFW/glfw3.h>
@@ -40,39 +73,38 @@ auto enable_debug_info()
 namespace
 {
 
-auto const vertex_shader_source = R"glsl(
-#version 450 core
-
-layout (location = 0) in vec3 pos;
-layout (location = 1) in vec2 texture_coords;
+auto parse_count(Commandline::CommandArgs const& args, std::size_t const fallback) -> tl::expected<std::size_t, std::string>
+{
+  if(args.empty()) return fallback;
 
-layout (location = 2) out vec2 out_texture_coords;
+  auto count = std::size_t(0);
+  auto const& arg = args.front();
+  auto const [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), count);
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+  if(error != std::errc() or end != arg.data() + arg.size() or count == 0) {
+    return tl::make_unexpected(fmt::format("'{}' is not a valid count", arg));
+  }
 
-void main()
-{
-  gl_Position = projection * view * model * vec4(pos, 1.0);
-  out_texture_coords = texture_coords;
+  return count;
 }
-)glsl";
-
-auto const frag_shader_source = R"glsl(
-  #version 450 core
 
-  layout(location = 2) in vec2 texture_coords;
+// Exact test against the cube itself, done in its local space where it's an axis aligned unit box.
+// Model matrices are affine, so distances along the transformed ray stay the same.
+auto intersect_cube(TransformStore const& transforms, std::uint32_t const cube, Ray const& ray, float const max_distance) -> tl::optional<float>
+{
+  auto model = glm::mat4();
+  write_model_matrices(transforms, cube, std::span(&model, 1));
 
-  out vec4 frag_color;
+  auto const to_local = glm::inverse(model);
+  auto const local_ray = Ray {
+    .origin = glm::vec3(to_local * glm::vec4(ray.origin, 1.0F)),
+    .direction = glm::vec3(to_local * glm::vec4(ray.direction, 0.0F)),
+  };
 
-  uniform sampler2D face_texture;
+  auto const unit_cube = Aabb { .min = glm::vec3(-0.5F), .max = glm::vec3(0.5F) };
 
-  void main()
-  {
-    frag_color = texture(face_texture, texture_coords);
-  }
-)glsl";
+  return intersect(local_ray, glm::vec3(1.0F) / local_ray.direction, unit_cube, max_distance);
+}
 
 } // namespace
 
@@ -115,114 +147,54 @@ auto Trujkont::run() -> int
 
   glfwSetFramebufferSizeCallback(window, callbacks::framebuffer_size_callback);
 
-  auto const vertex_shader = Shader(ShaderType::Vertex, vertex_shader_source);
-  if(vertex_shader.param<ShaderAttr::CompileStatus>() != GL_TRUE) {
-    fmt::print(stderr, "Vertex shader compilation failed! Log:\n\n{}\n", vertex_shader.log());
-    return -1;
-  }
+  // Programs linked by a previous run on the same driver are loaded from here instead of being compiled again.
+  program_binary::enable("cache/programs");
 
-  auto const frag_shader = Shader(ShaderType::Fragment, frag_shader_source);
-  if(frag_shader.param<ShaderAttr::CompileStatus>() != GL_TRUE) {
-    fmt::print(stderr, "Fragment shader compilation failed! Log:\n\n{}\n", frag_shader.log());
-    return -1;
-  }
-  auto shader_program = ShaderProgram(vertex_shader, frag_shader);
+  // Built with `trujkont-pack`, whatever isn't in it (or everything, without one) is loaded from loose files.
+  // Mounted before anything is loaded, jobs decoding images look assets up in it too.
+  assets::mount("assets.pack");
 
-  if(shader_program.param<ProgramAttr::LinkStatus>() != GL_TRUE) {
-    fmt::print(stderr, "Shader program linking failed! Log:\n\n{}\n", shader_program.log());
+  auto const cube_stages = std::array {
+    program_cache::StageFile { ShaderType::Vertex, "src/trujkont/shaders/cube.vert" },
+    program_cache::StageFile { ShaderType::Fragment, "src/trujkont/shaders/cube.frag" }
+  };
+
+  // Compiled in the background, cubes are simply not drawn until it's linked.
+  auto const cube_program_loaded = program_cache::load_async(cube_stages);
+  if(not cube_program_loaded) {
+    fmt::print(stderr, "{}", cube_program_loaded.error());
     return -1;
   }
 
-  shader_program.use();
-
-  // clang-format off
-  auto const attrs_per_vertex = 5;
-
-  auto const vertices = std::array {
-      -0.5F, -0.5F, -0.5F,  0.0F, 0.0F,
-      0.5F, -0.5F, -0.5F,  1.0F, 0.0F,
-      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
-      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
-      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F,
-      -0.5F, -0.5F, -0.5F,  0.0F, 0.0F,
-
-      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
-      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
-      0.5F,  0.5F,  0.5F,  1.0F, 1.0F,
-      0.5F,  0.5F,  0.5F,  1.0F, 1.0F,
-      -0.5F,  0.5F,  0.5F,  0.0F, 1.0F,
-      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
-
-      -0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-      -0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
-      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
-      -0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-
-      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
-      0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-      0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-      0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
-      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-
-      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-      0.5F, -0.5F, -0.5F,  1.0F, 1.0F,
-      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
-      0.5F, -0.5F,  0.5F,  1.0F, 0.0F,
-      -0.5F, -0.5F,  0.5F,  0.0F, 0.0F,
-      -0.5F, -0.5F, -0.5F,  0.0F, 1.0F,
-
-      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F,
-      0.5F,  0.5F, -0.5F,  1.0F, 1.0F,
-      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-      0.5F,  0.5F,  0.5F,  1.0F, 0.0F,
-      -0.5F,  0.5F,  0.5F,  0.0F, 0.0F,
-      -0.5F,  0.5F, -0.5F,  0.0F, 1.0F
-  };
-
-  // clang-format on
+  auto const& cube_program = *cube_program_loaded;
+  auto cube_program_generation = std::uint64_t(0);
+  auto cube_face_uniform = Uniform<int>();
 
   stbi_set_flip_vertically_on_load(static_cast<int>(true));
-  glEnable(GL_DEPTH_TEST);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  gl_state::set_enabled(GL_DEPTH_TEST, true);
+  gl_state::set_enabled(GL_BLEND, true);
+  gl_state::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  auto VAO = 0U;
-  glGenVertexArrays(1, &VAO);
+  auto cubes = InstancedCubes();
 
-  auto VBO = 0U;
-  glGenBuffers(1, &VBO);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  auto jobs = JobSystem();
 
-  glBindVertexArray(VAO);
+  // Every frame's instance matrices, uniform blocks and any other dynamic data are written straight into this.
+  // Both texture uploaders stage up to their budget into it before the cube matrices are allocated, so it's sized for
+  // the most cubes drawn at once on top of those, plus a little for uniforms, billboards and alignment.
+  auto constexpr max_cubes = std::size_t(256 * 1024);
+  auto constexpr other_frame_data_size = std::size_t(1024 * 1024);
+  auto constexpr frame_stream_size = max_cubes * sizeof(glm::mat4) + TextureLoader::default_upload_budget + TextureStreamer::default_upload_budget + other_frame_data_size;
+  auto frame_stream = StreamBuffer(static_cast<GLsizeiptr>(frame_stream_size));
 
-  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+  // Images are decoded on the jobs and uploaded over the next frames, showing a placeholder meanwhile.
+  auto texture_loader = TextureLoader(jobs, frame_stream);
 
-  // NOLINTNEXTLINE
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, attrs_per_vertex * sizeof(float), static_cast<void*>(0));
-  glEnableVertexAttribArray(0);
-
-  // NOLINTNEXTLINE
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, attrs_per_vertex * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
-  glEnableVertexAttribArray(1);
-
-  // clang-format off
-  auto const indices = std::array {
-    0, 1, 3,
-    1, 2, 3
-  };
-  // clang-format on
-
-  auto EBO = 0U;
-  glGenBuffers(1, &EBO);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(int), indices.data(), GL_STATIC_DRAW);
-
-  auto face_texture = Texture("assets/babushka.png", TextureFormat::RGB);
-  shader_program.set_uniform_1ui("face_texture", face_texture.get_slot());
+  // Baked with `trujkont-bake bc1 assets/babushka.png assets/babushka.tbc`, the face is streamed: only the mips the
+  // nearest cube is drawn at stay resident. Without it the whole image is decoded and uploaded instead.
+  auto texture_streamer = TextureStreamer(jobs, frame_stream);
+  auto const streamed_face = texture_streamer.load("assets/babushka.tbc");
+  auto const face_slot = streamed_face ? (*streamed_face)->get_slot() : texture_loader.load("assets/babushka.png", TextureFormat::RGB)->get_slot();
 
   auto delta_time = DeltaTime();
 
@@ -239,10 +211,71 @@ auto Trujkont::run() -> int
     glm::vec3(-1.3F, 1.0F, -1.5F)
   };
 
+  auto scene = Scene();
+
+  auto const cube_spin_axis = glm::vec3(0.5F, 1.0F, 0.0F);
+
+  for(auto i = std::size_t(0); i < cube_positions.size(); ++i) {
+    auto const cube = scene.create();
+
+    scene.add_instance(
+      cube,
+      MeshId::Cube,
+      Instance {
+        .position = cube_positions[i],
+        .rotation_axis = cube_spin_axis,
+        .spin_speed = static_cast<float>(i + 1) * glm::radians(25.0F),
+      }
+    );
+    scene.materials.add(cube, Material { .texture = face_slot });
+  }
+
+  auto& cube_instances = scene.instances(MeshId::Cube);
+  auto const& cube_transforms = cube_instances.transforms;
+
+  auto cube_visible = std::vector<std::uint32_t>(cube_instances.size());
+
+  // The cubes only spin in place, which doesn't change their bounding spheres, so the tree never needs a refit.
+  update_bounds(cube_instances, InstancedCubes::bounding_radius);
+
+  auto cube_bvh = Bvh();
+  cube_bvh.build(cube_instances.bounds);
+
+  auto gpu_culler = tl::optional<GpuCuller>();
+  if(GpuCuller::supported()) gpu_culler.emplace(InstancedCubes::index_count);
+
+  // Switched from the commandline thread, picked up at the start of the next frame.
+  auto culling_mode = std::atomic<CullingMode>(CullingMode::Cpu);
+
   auto camera = Camera(window);
+  auto camera_buffer = CameraBuffer(frame_stream);
+
+  // Same sized images share an array, and with it a single unit, each billboard just picks its layer.
+  auto texture_pool = TextureArrayPool();
+
+  auto const awesome_face = texture_pool.add("assets/awesomeface.png", TextureFormat::RGBA);
+  scene.billboards.add(
+    scene.create(),
+    BillboardSprite { .position = glm::vec3(1.0, 1.0, -5.0), .size = 1.0F, .layer = awesome_face.layer, .tint = { 255, 255, 255, 255 }, .region = {} }
+  );
+
+  // Small sprites share one atlas instead, a single draw picks each one's part of it.
+  auto const sprite_paths = std::array<std::filesystem::path, 3> { "assets/dritt.png", "assets/vhyrro.png", "assets/babushka.png" };
+  auto const sprite_atlas = TextureAtlas(sprite_paths);
+
+  auto atlas_sprites = std::vector<BillboardSprite>();
+
+  for(auto i = std::size_t(0); i < sprite_paths.size(); ++i) {
+    atlas_sprites.push_back(BillboardSprite {
+      .position = glm::vec3(-1.5F + 1.5F * static_cast<float>(i), 2.5F, -5.0F),
+      .size = 1.0F,
+      .layer = TextureAtlas::layer,
+      .tint = { 255, 255, 255, 255 },
+      .region = sprite_atlas.region(i),
+    });
+  }
 
-  auto const billboard_texture = Texture("assets/awesomeface.png", TextureFormat::RGBA);
-  auto face_billboard = Billboard(billboard_texture.get_slot(), glm::vec3(1.0, 1.0, -5.0));
+  auto billboards = BillboardBatch();
 
   auto commandline = Commandline();
 
@@ -253,6 +286,135 @@ auto Trujkont::run() -> int
     }
   );
 
+  commandline.add_command(
+    "gl-stats",
+    []([[maybe_unused]] Commandline::CommandArgs args) -> Commandline::CommandResult {
+      return gl_state::report();
+    }
+  );
+
+  commandline.add_command(
+    "programs",
+    []([[maybe_unused]] Commandline::CommandArgs args) -> Commandline::CommandResult {
+      return program_cache::report();
+    }
+  );
+
+  commandline.add_command(
+    "vram",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      if(args.empty()) return gpu_memory::report();
+
+      // Picked up by the next frame's `enforce`.
+      return parse_count(args, 0).map([](std::size_t const mebibytes) {
+        gpu_memory::set_budget(mebibytes * 1024 * 1024);
+        return gpu_memory::report();
+      });
+    }
+  );
+
+  commandline.add_command(
+    "streaming",
+    [&texture_streamer]([[maybe_unused]] Commandline::CommandArgs args) -> Commandline::CommandResult {
+      return texture_streamer.report();
+    }
+  );
+
+  commandline.add_command(
+    "mips",
+    []([[maybe_unused]] Commandline::CommandArgs args) -> Commandline::CommandResult {
+      return mip_cache_report();
+    }
+  );
+
+  commandline.add_command(
+    "assets",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      if(args.empty()) return assets::report();
+
+      if(args.front() != "verify") return tl::make_unexpected(fmt::format("'{}' is not verify", args.front()));
+
+      auto const corrupt = assets::verify();
+      if(corrupt.empty()) return assets::report() + "every asset matches its hash";
+
+      return tl::make_unexpected(fmt::format("corrupt: {}", fmt::join(corrupt, ", ")));
+    }
+  );
+
+  commandline.add_command(
+    "bench-transforms",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_count = 100'000;
+
+      return parse_count(args, default_count).map(benchmark_transforms);
+    }
+  );
+
+  commandline.add_command(
+    "bench-jobs",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_count = 1'000'000;
+
+      return parse_count(args, default_count).map(benchmark_jobs);
+    }
+  );
+
+  commandline.add_command(
+    "bench-culling",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_count = 1'000'000;
+
+      return parse_count(args, default_count).map(benchmark_culling);
+    }
+  );
+
+  commandline.add_command(
+    "bench-bvh",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_count = 100'000;
+
+      return parse_count(args, default_count).map(benchmark_bvh);
+    }
+  );
+
+  commandline.add_command(
+    "bench-bc",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_size = 1024;
+
+      return parse_count(args, default_size).map(benchmark_block_compression);
+    }
+  );
+
+  commandline.add_command(
+    "bench-pixels",
+    [](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      auto constexpr default_width = 3840;
+
+      return parse_count(args, default_width).map(benchmark_pixels);
+    }
+  );
+
+  commandline.add_command(
+    "culling",
+    [&culling_mode, gpu_supported = gpu_culler.has_value()](Commandline::CommandArgs args) -> Commandline::CommandResult {
+      if(args.empty()) return fmt::format("Culling: {}", culling_mode_name(culling_mode.load()));
+
+      for(auto const mode : { CullingMode::Off, CullingMode::Cpu, CullingMode::Bvh, CullingMode::Gpu }) {
+        if(args.front() != culling_mode_name(mode)) continue;
+
+        if(mode == CullingMode::Gpu and not gpu_supported) {
+          return tl::make_unexpected("GPU culling needs compute shaders, storage buffers and indirect draws");
+        }
+
+        culling_mode.store(mode);
+        return fmt::format("Culling: {}", culling_mode_name(mode));
+      }
+
+      return tl::make_unexpected(fmt::format("'{}' is not one of off, cpu, bvh, gpu", args.front()));
+    }
+  );
+
   commandline.add_command(
     "exit",
     [&commandline]([[maybe_unused]] Commandline::CommandArgs args) -> Commandline::CommandResult {
@@ -261,35 +423,141 @@ auto Trujkont::run() -> int
     }
   );
 
+  // Edited shaders are rebuilt in the background and swapped in at the start of a frame, no restart needed.
+  auto shader_watcher = ShaderWatcher("src/trujkont/shaders");
+
   auto commandline_thread = std::jthread(&Commandline::run, commandline);
 
+  // Reported once each time the cubes stop fitting, not every frame they don't.
+  auto cubes_dropped = false;
+
   while(glfwWindowShouldClose(window) == 0) {
-    shader_program.use();
+    frame_stream.begin_frame();
+
+    // Before anything is drawn, so what was on screen last frame is still marked as used and stays.
+    gpu_memory::enforce();
+
+    program_cache::reload(shader_watcher.take_changes());
+    program_cache::poll();
+
+    texture_loader.update();
+    texture_pool.update();
+
+    // Uniform handles belong to a program, a newly linked one needs them looked up again.
+    if(cube_program->generation() != cube_program_generation) {
+      cube_program_generation = cube_program->generation();
+      cube_face_uniform = cube_program->current()->uniform<int>("face_texture");
+    }
+
+    auto const frame_time = delta_time.get();
+
+    auto const [view, projection] = camera.update(frame_time, static_cast<float>(window_width) / window_height);
+    camera_buffer.update(view, projection, camera.position);
+
+    if(auto const pick_ray = camera.take_pick_ray(view, projection)) {
+      auto const hit = cube_bvh.raycast(*pick_ray, std::numeric_limits<float>::max(), [&](std::uint32_t const cube, [[maybe_unused]] float const box_distance) {
+        return intersect_cube(cube_transforms, cube, *pick_ray, std::numeric_limits<float>::max());
+      });
+
+      if(hit) {
+        auto const entity = cube_instances.entities[hit->object];
+        fmt::print("Picked entity {}v{} at distance {:.2f}\n", entity.index, entity.generation, hit->distance);
+      } else {
+        fmt::print("Picked nothing\n");
+      }
+    }
 
     glClearColor(0.1F, 0.1F, 0.1F, 1.0F);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glBindVertexArray(VAO);
+    auto constexpr milliseconds_per_second = 1000.0F;
+    spin_instances(cube_instances, static_cast<float>(frame_time) / milliseconds_per_second);
 
-    auto constexpr cubes = 10;
-    for(auto i = 1; i <= cubes; ++i) {
-      auto model = glm::mat4(1.0F);
-      model = glm::translate(model, cube_positions[i - 1]);
+    // CPU culling only builds the matrices of visible cubes, otherwise all of them are built, and the GPU culls them itself.
+    // Until its compute program is linked, the GPU culler is stood in for by the CPU one.
+    auto const requested_culling = culling_mode.load();
+    auto const culling = requested_culling == CullingMode::Gpu and not gpu_culler->ready() ? CullingMode::Cpu : requested_culling;
+    auto const culls_on_cpu = culling == CullingMode::Cpu or culling == CullingMode::Bvh;
 
-      model = glm::rotate(model, static_cast<float>(i) * (float)glfwGetTime() * glm::radians(25.0F), glm::vec3(0.5F, 1.0F, 0.0F));
+    auto visible_count = std::size_t(0);
+    if(culling == CullingMode::Cpu) {
+      visible_count = cull_spheres(cube_transforms, InstancedCubes::bounding_radius, Frustum(projection * view), cube_visible);
+    } else if(culling == CullingMode::Bvh) {
+      visible_count = cube_bvh.query(Frustum(projection * view), cube_visible);
+    }
+
+    auto const visible_cubes = std::span(cube_visible).first(visible_count);
 
-      shader_program.set_uniform_4mat("model", model);
+    // Every cube shares the face, whichever one covers the most pixels decides how sharp it has to be.
+    if(streamed_face) {
+      auto const request_face = [&](std::uint32_t const cube) {
+        auto const distance = glm::distance(cube_instances.bounds[cube].center(), camera.position);
+        texture_streamer.request(**streamed_face, projected_size(InstancedCubes::bounding_radius, distance, camera.field_of_view, window_height));
+      };
 
-      glDrawArrays(GL_TRIANGLES, 0, 36);
+      if(culls_on_cpu) {
+        std::ranges::for_each(visible_cubes, request_face);
+      } else {
+        std::ranges::for_each(std::views::iota(std::uint32_t(0), static_cast<std::uint32_t>(cube_instances.size())), request_face);
+      }
     }
 
-    auto const [view, projection] = camera.update(delta_time.get(), static_cast<float>(window_width) / window_height);
+    texture_streamer.update();
+
+    auto const cubes_count = culls_on_cpu ? visible_cubes.size() : cube_transforms.size();
+    auto const models_alignment = culling == CullingMode::Gpu ? gpu_culler->source_alignment() : alignof(glm::mat4);
+
+    auto const* const cube_shader = cube_program->current();
+
+    auto cube_models = frame_stream.allocate<glm::mat4>(cubes_count, models_alignment);
+
+    if(not cube_models and not cubes_dropped) {
+      fmt::print(stderr, "No room for {} cube matrices in the frame stream (made for {}), not drawing them.\n", cubes_count, max_cubes);
+    }
+    cubes_dropped = not cube_models;
+
+    // All the cubes go out in one draw, which samples one texture: the material of the first one, the rest share it.
+    auto const* const cube_material = cube_instances.size() != 0 ? scene.materials.get(cube_instances.entities.front()) : nullptr;
+
+    if(cube_models and cubes_count != 0 and cube_shader and cube_material) {
+      cube_face_uniform.set(static_cast<int>(cube_material->texture));
+
+      // Small scenes end up as a single chunk, which parallel_for runs inline without touching the workers.
+      auto constexpr transforms_per_job = std::size_t(16384);
+
+      auto models_written = JobCounter();
+      jobs.parallel_for(
+        0,
+        cubes_count,
+        transforms_per_job,
+        [&](std::size_t const begin, std::size_t const end) {
+          auto const models = cube_models->data.subspan(begin, end - begin);
+
+          if(culls_on_cpu) {
+            write_model_matrices(cube_transforms, visible_cubes.subspan(begin, end - begin), models);
+          } else {
+            write_model_matrices(cube_transforms, begin, models);
+          }
+        },
+        models_written
+      );
+      jobs.wait(models_written);
+
+      if(culling == CullingMode::Gpu) {
+        gpu_culler->cull(frame_stream.id(), cube_models->offset, cubes_count, InstancedCubes::bounding_radius);
+
+        cube_shader->use();
+        cubes.draw_indirect(gpu_culler->instance_buffer(), gpu_culler->command_buffer());
+      } else {
+        cube_shader->use();
+        cubes.draw(frame_stream.id(), cube_models->offset, cubes_count);
+      }
+    }
 
-    face_billboard.update(view, projection);
+    billboards.draw(frame_stream, scene.billboards.values(), awesome_face.slot);
+    billboards.draw(frame_stream, atlas_sprites, sprite_atlas.get_slot());
 
-    shader_program.use();
-    shader_program.set_uniform_4mat("view", view);
-    shader_program.set_uniform_4mat("projection", projection);
+    frame_stream.end_frame();
 
     glfwSwapBuffers(window);
     glfwPollEvents();
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <unordered_map>
+#include <type_traits>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <fmt/format.h>
+
+template<typename Vertex>
+struct IndexedMesh
+{
+  std::vector<Vertex> vertices;
+  std::vector<std::uint16_t> indices;
+
+  auto inline static constexpr index_type = GLenum(GL_UNSIGNED_SHORT);
+
+  [[nodiscard]] auto vertices_size() const noexcept -> std::size_t { return vertices.size() * sizeof(Vertex); }
+
+  [[nodiscard]] auto indices_size() const noexcept -> std::size_t { return indices.size() * sizeof(std::uint16_t); }
+};
+
+// Merges identical vertices of a triangle list, each one is kept where it first appears so neighbouring triangles keep
+// sharing nearby vertices. Run it on packed vertices: ones that only differed below the packed precision merge too.
+// Throws `std::length_error` when more unique vertices remain than 16 bit indices address.
+template<typename Vertex>
+[[nodiscard]] auto index_vertices(std::span<Vertex const> const triangles) -> IndexedMesh<Vertex>
+{
+  // Compared byte by byte, which only means equal for types without padding.
+  static_assert(std::has_unique_object_representations_v<Vertex>, "Vertices are deduplicated by their bytes, they must not have padding");
+
+  auto mesh = IndexedMesh<Vertex>();
+  mesh.indices.reserve(triangles.size());
+
+  // Keyed by views of the vertices in `triangles`, which outlives the map.
+  auto unique = std::unordered_map<std::string_view, std::uint16_t>();
+
+  for(auto const& vertex : triangles) {
+    auto const bytes = std::string_view(reinterpret_cast<char const*>(&vertex), sizeof(Vertex)); // NOLINT
+
+    auto const [found, inserted] = unique.try_emplace(bytes, static_cast<std::uint16_t>(mesh.vertices.size()));
+
+    if(inserted) {
+      if(mesh.vertices.size() > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::length_error(fmt::format("More than {} unique vertices for 16 bit indices", std::numeric_limits<std::uint16_t>::max() + 1));
+      }
+
+      mesh.vertices.push_back(vertex);
+    }
+
+    mesh.indices.push_back(found->second);
+  }
+
+  return mesh;
+}
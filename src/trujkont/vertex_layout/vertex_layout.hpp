@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <cmath>
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+// Packed attribute formats, each knowing how GL reads it, and layouts of vertex structs built from them, which set up
+// a vertex array's attributes from nothing but their types:
+//
+//   struct MeshVertex
+//   {
+//     Snorm16x3 position;
+//     Half2 texture_coords;
+//   };
+//
+//   using MeshLayout = VertexLayout<MeshVertex, VertexAttribute<0, Snorm16x3, offsetof(MeshVertex, position)>, ...>;
+//
+//   MeshLayout::setup(); // with the vertex array and the vertex buffer bound
+//
+// Locations, offsets and sizes are checked at compile time.
+
+// Three signed normalized 16 bit components in [-1, 1], padded to 8 bytes so the next attribute stays 4 byte aligned.
+// For positions divided by the mesh's extent, which the vertex shader multiplies them back by.
+struct Snorm16x3
+{
+  std::array<std::int16_t, 4> values = {};
+
+  auto inline static constexpr components = GLint(3);
+  auto inline static constexpr type = GLenum(GL_SHORT);
+  auto inline static constexpr normalized = GLboolean(GL_TRUE);
+
+  [[nodiscard]] auto static pack(glm::vec3 const value) -> Snorm16x3
+  {
+    auto const component = [](float const x) {
+      return static_cast<std::int16_t>(std::lround(std::clamp(x, -1.0F, 1.0F) * 32767.0F)); // NOLINT(*-magic-numbers)
+    };
+
+    return Snorm16x3 { .values = { component(value.x), component(value.y), component(value.z), 0 } };
+  }
+};
+
+// Two half floats, for texture coordinates: exact for the usual 0 and 1 and within 1/2048 of anything in between.
+struct Half2
+{
+  std::array<std::uint16_t, 2> values = {};
+
+  auto inline static constexpr components = GLint(2);
+  auto inline static constexpr type = GLenum(GL_HALF_FLOAT);
+  auto inline static constexpr normalized = GLboolean(GL_FALSE);
+
+  [[nodiscard]] auto static pack(glm::vec2 const value) -> Half2
+  {
+    return Half2 { .values = { glm::packHalf1x16(value.x), glm::packHalf1x16(value.y) } };
+  }
+};
+
+// A unit vector in three signed normalized 10 bit components and two unused bits, for normals and tangents.
+// GL only reads the packed format as four components, the shader declares it as a `vec3` and drops the fourth.
+struct Snorm10x3
+{
+  std::uint32_t bits = 0;
+
+  auto inline static constexpr components = GLint(4);
+  auto inline static constexpr type = GLenum(GL_INT_2_10_10_10_REV);
+  auto inline static constexpr normalized = GLboolean(GL_TRUE);
+
+  [[nodiscard]] auto static pack(glm::vec3 const value) -> Snorm10x3
+  {
+    return Snorm10x3 { .bits = glm::packSnorm3x10_1x2(glm::vec4(value, 0.0F)) };
+  }
+};
+
+template<GLuint Location, typename Format, std::size_t Offset>
+struct VertexAttribute
+{
+  using format = Format;
+
+  auto inline static constexpr location = Location;
+  auto inline static constexpr offset = Offset;
+  auto inline static constexpr size = sizeof(Format);
+
+  // GL wants every attribute 4 byte aligned, some drivers silently fall back to a slow path otherwise.
+  static_assert(Offset % 4 == 0, "Vertex attributes must be 4 byte aligned");
+
+  auto static setup(GLsizei const stride) -> void
+  {
+    glVertexAttribPointer(Location, Format::components, Format::type, Format::normalized, stride, reinterpret_cast<void*>(Offset)); // NOLINT
+    glEnableVertexAttribArray(Location);
+  }
+};
+
+template<typename Vertex, typename... Attributes>
+struct VertexLayout
+{
+  using vertex = Vertex;
+
+  auto inline static constexpr stride = static_cast<GLsizei>(sizeof(Vertex));
+
+  // For per instance attributes that follow the vertex ones.
+  auto inline static constexpr first_free_location = std::max({ (Attributes::location + 1)... });
+
+  static_assert(sizeof...(Attributes) > 0, "A vertex layout needs at least one attribute");
+  static_assert(((Attributes::offset + Attributes::size <= sizeof(Vertex)) and ...), "A vertex attribute reaches past the end of its vertex");
+
+  static_assert(
+    [] {
+      auto const locations = std::array { Attributes::location... };
+
+      for(auto i = std::size_t(0); i < locations.size(); ++i) {
+        for(auto j = i + 1; j < locations.size(); ++j) {
+          if(locations[i] == locations[j]) return false;
+        }
+      }
+
+      return true;
+    }(),
+    "Vertex attributes must have distinct locations"
+  );
+
+  // Points the bound vertex array's attributes at the buffer bound to `GL_ARRAY_BUFFER` and enables them.
+  auto static setup() -> void { (Attributes::setup(stride), ...); }
+};